@@ -0,0 +1,48 @@
+/**
+ * @file blit.h
+ * @brief 1-bpp sprite and text blitter. Coordinates are as seen on the panel:
+ * x = 0 is the left column and y = 0 the top line, which is framebuffer row
+ * ROWS - 1 (the panel is mounted with row 0 at the bottom).
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_BLIT_H
+#define MY_BLIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "models.h"
+
+// Packed 1-bpp bitmap, rows top to bottom, (w + 7) / 8 bytes per row, the
+// most significant bit of the first byte is the leftmost pixel
+typedef struct {
+  uint8_t w;  // 1..32
+  uint8_t h;
+  const uint8_t *rows;
+} Sprite;
+
+// Text moving right to left across the panel, one pixel every period ticks.
+// Text that fits the panel is centred and held for the same time instead.
+typedef struct {
+  const char *text;
+  int width;      // pixels
+  int y;
+  color_t color;
+  uint8_t period;
+  uint8_t wait;   // ticks until the next step
+  int step;       // steps done, width + COLS make a pass
+} TextScroll;
+
+void blit(color_t (*fb)[COLS], const Sprite *sprite, int x, int y,
+          color_t color);
+int text_width(const char *text);
+int text_draw(color_t (*fb)[COLS], const char *text, int x, int y,
+              color_t color);
+void text_scroll_start(TextScroll *ts, const char *text, int y, color_t color,
+                       uint8_t period);
+bool text_scroll_tick(TextScroll *ts);
+bool text_scroll_done(const TextScroll *ts);
+void text_scroll_draw(const TextScroll *ts, color_t (*fb)[COLS]);
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * @file brightness.h
+ * @brief Fixed-point brightness and gamma stage between the framebuffer and
+ * the TLC5947 greyscale values.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_BRIGHTNESS_H
+#define MY_BRIGHTNESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BRIGHTNESS_MAX 256    // full scale, the level is level/256
+#define GAMMA_LINEAR 100      // gamma is given in hundredths
+#define BRIGHTNESS_LUT_SIZE 257  // knots every 16 steps of the 12-bit input
+
+// Table in use, owned by the scan and swapped by brightness_acquire
+extern const uint16_t *brightness_lut;
+
+void brightness_init(uint16_t level, uint16_t gamma_x100);
+void brightness_set(uint16_t level);
+uint16_t brightness_get(void);
+void gamma_set(uint16_t gamma_x100);
+uint16_t gamma_get(void);
+bool brightness_acquire(void);
+
+/**
+ * @brief Maps a 12-bit framebuffer value through the current brightness and
+ * gamma table. Integer only, interpolates between the 16-step knots.
+ * @param v Value 0..4095 (upper bits are ignored).
+ * @return Greyscale value 0..4095.
+ */
+static inline uint16_t brightness_apply(uint16_t v) {
+  const uint16_t *lut = brightness_lut;
+  v &= 0x0FFF;
+  uint32_t i = v >> 4;
+  uint32_t f = v & 0x0F;
+  return (uint16_t)(lut[i] + (((uint32_t)(lut[i + 1] - lut[i]) * f) >> 4));
+}
+
+#endif
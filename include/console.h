@@ -0,0 +1,11 @@
+/**
+ * @file console.h
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_CONSOLE_H
+#define MY_CONSOLE_H
+
+void console_poll(void);
+
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file difficulties.h
+ * @brief Entries of the DIFFICULTIES table (models.c), as initializers so the
+ * tick kernels of game.c can compile each entry in as constants.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_DIFFICULTIES_H
+#define MY_DIFFICULTIES_H
+
+#include "models.h"
+
+// The limits the engine depends on are macros of their own, checked below
+#define DIF_EASY_MOVE_MS 250
+#define DIF_EASY_FOOD_MS 3000
+#define DIF_EASY_EVIL_FOOD_MS 6000
+#define DIF_EASY_FRUIT_TTL_MS 15000
+#define DIF_EASY_EVIL_FRUIT_TTL_MS 6500
+#define DIF_EASY_MAX_FRUIT 3
+#define DIF_EASY_MAX_EVIL_FRUIT 1
+#define DIF_EASY_INIT                                                   \
+  {.name = DIFF_EASY,                                                   \
+   .move_ms = DIF_EASY_MOVE_MS,                                         \
+   .food_ms = DIF_EASY_FOOD_MS,                                         \
+   .evil_food_ms = DIF_EASY_EVIL_FOOD_MS,                               \
+   .food_spawn_chance = 80,                                             \
+   .evil_food_spawn_chance = 20,                                        \
+   .min_snake_len = 4,                                                  \
+   .max_fruit = DIF_EASY_MAX_FRUIT,                                     \
+   .max_evil_fruit = DIF_EASY_MAX_EVIL_FRUIT,                           \
+   .fruit_ttl_ms = DIF_EASY_FRUIT_TTL_MS,                               \
+   .evil_fruit_ttl_ms = DIF_EASY_EVIL_FRUIT_TTL_MS,                     \
+   .winning_len = 30,                                                   \
+   .good_inc = 1,                                                       \
+   .evil_dec = 1}
+
+#define DIF_MEDIUM_MOVE_MS 150
+#define DIF_MEDIUM_FOOD_MS 3000
+#define DIF_MEDIUM_EVIL_FOOD_MS 3500
+#define DIF_MEDIUM_FRUIT_TTL_MS 15000
+#define DIF_MEDIUM_EVIL_FRUIT_TTL_MS 18000
+#define DIF_MEDIUM_MAX_FRUIT 5
+#define DIF_MEDIUM_MAX_EVIL_FRUIT 5
+#define DIF_MEDIUM_INIT                                                 \
+  {.name = DIFF_MEDIUM,                                                 \
+   .move_ms = DIF_MEDIUM_MOVE_MS,                                       \
+   .food_ms = DIF_MEDIUM_FOOD_MS,                                       \
+   .evil_food_ms = DIF_MEDIUM_EVIL_FOOD_MS,                             \
+   .food_spawn_chance = 60,                                             \
+   .evil_food_spawn_chance = 40,                                        \
+   .max_fruit = DIF_MEDIUM_MAX_FRUIT,                                   \
+   .max_evil_fruit = DIF_MEDIUM_MAX_EVIL_FRUIT,                         \
+   .fruit_ttl_ms = DIF_MEDIUM_FRUIT_TTL_MS,                             \
+   .evil_fruit_ttl_ms = DIF_MEDIUM_EVIL_FRUIT_TTL_MS,                   \
+   .min_snake_len = 5,                                                  \
+   .winning_len = 40,                                                   \
+   .good_inc = 2,                                                       \
+   .evil_dec = 2}
+
+#define DIF_HARD_MOVE_MS 100
+#define DIF_HARD_FOOD_MS 3000
+#define DIF_HARD_EVIL_FOOD_MS 3500
+#define DIF_HARD_FRUIT_TTL_MS 12000
+#define DIF_HARD_EVIL_FRUIT_TTL_MS 19500
+#define DIF_HARD_MAX_FRUIT 4
+#define DIF_HARD_MAX_EVIL_FRUIT 6
+#define DIF_HARD_INIT                                                   \
+  {.name = DIFF_HARD,                                                   \
+   .move_ms = DIF_HARD_MOVE_MS,                                         \
+   .food_ms = DIF_HARD_FOOD_MS,                                         \
+   .evil_food_ms = DIF_HARD_EVIL_FOOD_MS,                               \
+   .food_spawn_chance = 40,                                             \
+   .evil_food_spawn_chance = 60,                                        \
+   .max_fruit = DIF_HARD_MAX_FRUIT,                                     \
+   .max_evil_fruit = DIF_HARD_MAX_EVIL_FRUIT,                           \
+   .fruit_ttl_ms = DIF_HARD_FRUIT_TTL_MS,                               \
+   .evil_fruit_ttl_ms = DIF_HARD_EVIL_FRUIT_TTL_MS,                     \
+   .min_snake_len = 6,                                                  \
+   .winning_len = 60,                                                   \
+   .good_inc = 3,                                                       \
+   .evil_dec = 5}
+
+// Every fruit an entry allows at once needs a slot of the fruit pool
+#if DIF_EASY_MAX_FRUIT + DIF_EASY_MAX_EVIL_FRUIT > FRUIT_POOL_SIZE ||     \
+    DIF_MEDIUM_MAX_FRUIT + DIF_MEDIUM_MAX_EVIL_FRUIT > FRUIT_POOL_SIZE || \
+    DIF_HARD_MAX_FRUIT + DIF_HARD_MAX_EVIL_FRUIT > FRUIT_POOL_SIZE
+#error "FRUIT_POOL_SIZE is below max_fruit + max_evil_fruit of a difficulty"
+#endif
+
+// Periods are whole logic ticks, anything else would change with the rate
+#define DIF_PERIOD_BAD(ms) ((ms) < LOGIC_TICK_MS || (ms) % LOGIC_TICK_MS != 0)
+#if DIF_PERIOD_BAD(DIF_EASY_MOVE_MS) ||             \
+    DIF_PERIOD_BAD(DIF_EASY_FOOD_MS) ||             \
+    DIF_PERIOD_BAD(DIF_EASY_EVIL_FOOD_MS) ||        \
+    DIF_PERIOD_BAD(DIF_EASY_FRUIT_TTL_MS) ||        \
+    DIF_PERIOD_BAD(DIF_EASY_EVIL_FRUIT_TTL_MS) ||   \
+    DIF_PERIOD_BAD(DIF_MEDIUM_MOVE_MS) ||           \
+    DIF_PERIOD_BAD(DIF_MEDIUM_FOOD_MS) ||           \
+    DIF_PERIOD_BAD(DIF_MEDIUM_EVIL_FOOD_MS) ||      \
+    DIF_PERIOD_BAD(DIF_MEDIUM_FRUIT_TTL_MS) ||      \
+    DIF_PERIOD_BAD(DIF_MEDIUM_EVIL_FRUIT_TTL_MS) || \
+    DIF_PERIOD_BAD(DIF_HARD_MOVE_MS) ||             \
+    DIF_PERIOD_BAD(DIF_HARD_FOOD_MS) ||             \
+    DIF_PERIOD_BAD(DIF_HARD_EVIL_FOOD_MS) ||        \
+    DIF_PERIOD_BAD(DIF_HARD_FRUIT_TTL_MS) ||        \
+    DIF_PERIOD_BAD(DIF_HARD_EVIL_FRUIT_TTL_MS)
+#error "a difficulty period is not a multiple of LOGIC_TICK_MS"
+#endif
+
+#endif
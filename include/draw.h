@@ -8,9 +8,11 @@
 #include "models.h"
 
 void fb_clear();
+void fb_invalidate();
 void fb_swap();
-void draw_won();
-void draw_lost();
+void draw_init();
+void draw_won(GameManager *gm);
+void draw_lost(GameManager *gm);
 void draw_idle(GameManager *gm);
 void draw_running(GameManager *gm);
 
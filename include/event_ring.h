@@ -0,0 +1,38 @@
+/**
+ * @file event_ring.h
+ * @brief Lock-free single producer / single consumer ring of button events,
+ * filled by the button ISR and drained by the game task.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_EVENT_RING_H
+#define MY_EVENT_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "models.h"
+
+#define EVENT_RING_SIZE 16  // power of 2
+
+// A button press as the ISR saw it
+typedef struct {
+  uint32_t t_us;  // esp_timer time of the press, wraps after ~71 minutes
+  uint8_t dir;    // Direction of the button
+} ButtonEvent;
+
+// head is written only by the producer, tail only by the consumer
+typedef struct {
+  ButtonEvent ev[EVENT_RING_SIZE];
+  _Atomic uint32_t head;  // events pushed so far
+  _Atomic uint32_t tail;  // events popped so far
+  uint32_t dropped;       // pushes that found the ring full
+} EventRing;
+
+void event_ring_clear(EventRing *ring);
+bool event_ring_push(EventRing *ring, ButtonEvent ev);
+bool event_ring_pop(EventRing *ring, ButtonEvent *ev);
+bool event_ring_peek(EventRing *ring, ButtonEvent *ev);
+
+#endif
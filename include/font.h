@@ -0,0 +1,20 @@
+/**
+ * @file font.h
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_FONT_H
+#define MY_FONT_H
+
+#include <stdint.h>
+
+#define FONT_W 3
+#define FONT_H 5
+#define FONT_ADVANCE (FONT_W + 1)  // one column between glyphs
+#define FONT_FIRST ' '
+#define FONT_LAST 'Z'
+
+// Glyph rows of FONT_FIRST..FONT_LAST, lower case is drawn as upper case
+extern const uint8_t FONT_GLYPHS[FONT_LAST - FONT_FIRST + 1][FONT_H];
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * @file frame_buffers.h
+ * @brief Triple-buffered framebuffers shared by the renderer (game tick) and
+ * the scanner (multiplex timer).
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_FRAME_BUFFERS_H
+#define MY_FRAME_BUFFERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "models.h"
+
+#define FB_COUNT 3        // drawable buffers
+#define FB_STATIC_MAX 8   // constant frames that can be registered
+#define FB_STATIC_NONE 0xFF
+
+// Frame counters, each one has a single writer
+typedef struct {
+  uint32_t published;  // frames handed over by the renderer
+  uint32_t shown;      // frames the scanner switched to
+  uint32_t dropped;    // published frames replaced before they were shown
+  uint32_t repeated;   // frame boundaries without a new frame
+} FbStats;
+
+extern color_t (*fb_draw)[COLS];     // rendered to, owned by the renderer
+extern const color_t (*fb_display)[COLS];  // scanned, owned by the scanner
+
+void fb_init(void);
+uint8_t fb_add_static(const color_t (*frame)[COLS]);
+uint32_t fb_publish(void);
+uint32_t fb_publish_static(uint8_t id);
+bool fb_acquire(void);
+int fb_draw_index(void);
+uint32_t fb_shown_seq(void);
+uint32_t fb_published_seq(void);
+void fb_get_stats(FbStats *stats);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file fruit_pool.h
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_FRUIT_POOL_H
+#define MY_FRUIT_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "models.h"
+
+void fruit_pool_init(FruitPool *pool);
+bool fruit_pool_alloc(FruitPool *pool, uint8_t *slot);
+void fruit_pool_release(FruitPool *pool, uint8_t slot);
+
+// Number of live fruits
+static inline size_t fruit_pool_count(const FruitPool *pool) {
+  return pool->active_count;
+}
+
+// The i-th live fruit, 0 <= i < fruit_pool_count
+static inline Fruit *fruit_pool_active(FruitPool *pool, size_t i) {
+  return &pool->slots[pool->active[i]];
+}
+
+#endif
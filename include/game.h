@@ -10,18 +10,46 @@
 
 #include "models.h"
 
+/**
+ * @brief Returns the i-th segment of the snake, 0 is the head.
+ * @note The body is a ring buffer, segments follow the head with wrap-around.
+ */
+static inline Pos *snake_segment(Snake *snake, size_t i) {
+  size_t idx = snake->head + i;
+  if (idx >= ROWS * COLS) idx -= ROWS * COLS;
+  return &snake->body[idx];
+}
+
+// Board cell of a position, row-major
+static inline size_t cell_index(Pos p) { return (size_t)p.r * COLS + p.c; }
+
+static inline bool occ_test(const uint32_t *occ, size_t cell) {
+  return (occ[cell >> 5] >> (cell & 31)) & 1u;
+}
+
+static inline void occ_set(uint32_t *occ, size_t cell) {
+  occ[cell >> 5] |= 1u << (cell & 31);
+}
+
+static inline void occ_clear(uint32_t *occ, size_t cell) {
+  occ[cell >> 5] &= ~(1u << (cell & 31));
+}
+
 bool is_collision(Pos *a, Pos *b);
 bool collision_detected(GameManager *gm);
 bool food_eaten(GameManager *gm, bool *is_evil);
-size_t get_free_index(GameManager *gm);
-bool should_spawn_fruit(GameManager *gm);
-void remove_expired_fruits(GameManager *gm);
-bool should_spawn_evil_fruit(GameManager *gm);
+void expire_fruit(GameManager *gm, uint8_t slot);
 Pos get_pos(GameManager *gm, bool *_valid);
 Difficulty get_next_difficulty(Difficulty current);
 Difficulty get_prev_difficulty(Difficulty current);
 State check_conditions(GameManager *gm);
-void spawn_fruit(GameManager *gm);
+void spawn_fruit(GameManager *gm, bool is_evil);
 void move_snake(GameManager *gm, Queue *direction);
+void occupancy_rebuild(GameManager *gm);
+void game_reset(GameManager *gm, const Dif *difficulty, uint32_t seed);
+void game_set_difficulty(GameManager *gm, const Dif *difficulty);
+uint32_t game_hash(const GameManager *gm);
+State game_tick(GameManager *gm, Queue *direction);
+TickKernel tick_kernel_for(const Dif *d);
 
 #endif
\ No newline at end of file
@@ -7,19 +7,13 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
+#include "event_ring.h"
 #include "freertos/FreeRTOS.h"
 #include "models.h"
 
 // ======= Globals (defined in main.c) ======
 extern Queue direction;  // Direction input queue
-// Double-buffered framebuffers.
-extern rgb16_t (*fb_display)[COLS];  // scanned
-extern rgb16_t (*fb_draw)[COLS];     // rendered to
-extern rgb16_t fb_buf0[ROWS][COLS];  // holds data
-extern rgb16_t fb_buf1[ROWS][COLS];  // holds data
-extern rgb16_t fb0[ROWS][COLS];      // baseline copy of initial cleared buffer
-
-// Frame is ready to be swapped and displayed
-extern volatile bool fb_swap_pending;
+extern EventRing button_events;  // Presses from the button ISR
+// Framebuffers are in frame_buffers.h
 
 #endif
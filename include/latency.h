@@ -0,0 +1,44 @@
+/**
+ * @file latency.h
+ * @brief Input-to-photon latency of turns: every accepted press is followed
+ * from the button edge to the first frame boundary that shows its move.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_LATENCY_H
+#define MY_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "models.h"
+
+// Stages of a press, each one ends at the next timestamp
+typedef enum {
+  LAT_BIND,     // button edge -> bound by the game task
+  LAT_MOVE,     // bound -> the snake move that took it from the queue
+  LAT_PUBLISH,  // move -> the frame drawing it handed to the scanner
+  LAT_SHOW,     // published -> the scanner switched to it (column 0)
+  LAT_STAGES
+} LatStage;
+
+// Summary of one difficulty, times in microseconds
+typedef struct {
+  uint32_t count;                 // presses that reached the panel
+  uint32_t p50_us, p99_us;        // from the histogram, within 1/16
+  uint32_t max_us;                // exact
+  uint32_t stage_mean_us[LAT_STAGES];
+  uint32_t stage_max_us[LAT_STAGES];
+} LatReport;
+
+void latency_reset(void);
+void latency_bound(Difficulty diff, uint32_t t_press);
+void latency_moved(void);
+void latency_published(uint32_t seq);
+void latency_poll(void);
+void latency_cancel(void);
+void latency_frame_shown(uint32_t seq);
+void latency_report(Difficulty diff, LatReport *out);
+void latency_print(void);
+
+#endif
@@ -8,15 +8,70 @@
 
 #include <stdint.h>
 
+#include "rng.h"
 #include "tlc5947.h"
 
 #define QUEUE_SIZE 5
+// Rate of the game logic (scheduler ticks). The difficulty table is in ms and
+// converted, so the gameplay is the same at any rate that divides its periods
+#ifndef LOGIC_RATE_HZ
+#define LOGIC_RATE_HZ 20
+#endif
+#if 1000 % LOGIC_RATE_HZ != 0
+#error "LOGIC_RATE_HZ must divide 1000, a tick is a whole number of ms"
+#endif
+#define LOGIC_TICK_MS (1000 / LOGIC_RATE_HZ)
+// Rate frames are drawn at, the logic catches up in LOGIC_TICK_MS steps
+#ifndef RENDER_RATE_HZ
+#define RENDER_RATE_HZ 20
+#endif
+#define BOARD_CELLS (ROWS * COLS)
+#define OCC_WORDS ((BOARD_CELLS + 31) / 32)  // 32 cells per bitmap word
+// Fruits alive at once, must be >= max_fruit + max_evil_fruit of every entry
+// in DIFFICULTIES (10 for medium and hard), difficulties.h checks it
+#define FRUIT_POOL_SIZE 10
+// Cells a game tick may change: head, old head, two tail cells, two spawns
+// and every fruit expiring, more marks a full redraw
+#define GM_DIRTY_MAX (6 + FRUIT_POOL_SIZE)
+
+// Narrowest types that fit the board, signed so Pos also holds the -1 deltas
+#if ROWS <= INT8_MAX && COLS <= INT8_MAX
+typedef int8_t coord_t;
+#else
+typedef int16_t coord_t;
+#endif
+#if BOARD_CELLS <= UINT16_MAX
+typedef uint16_t cell_t;  // cell index or count of cells
+#else
+typedef uint32_t cell_t;
+#endif
 
 // Pixel
 typedef struct {
   uint16_t r, g, b;
 } rgb16_t;
 
+// Framebuffer pixel, an index into PALETTE
+typedef uint8_t color_t;
+
+// Palette indices (colors defined in models.c), 0 must stay black so that a
+// zeroed framebuffer is blank
+enum {
+  BLACK_COLOR,
+  SNAKE_COLOR,
+  SNAKE_HEAD_COLOR,
+  FRUIT_COLOR,
+  EVIL_FRUIT_COLOR,
+  TEXT_COLOR,
+  EASY_COLOR,
+  MEDIUM_COLOR,
+  HARD_COLOR,
+  SELECTED_COLOR,
+  LOST_COLOR,
+  WON_COLOR,
+  PALETTE_SIZE
+};
+
 typedef enum {
   DIR_UP,
   DIR_DOWN,
@@ -27,8 +82,8 @@ typedef enum {
 
 // Position in the framebuffer
 typedef struct {
-  int r;
-  int c;
+  coord_t r;
+  coord_t c;
 } Pos;
 
 // Direction with metadata
@@ -40,9 +95,10 @@ typedef struct {
 
 // Snake model
 typedef struct {
-  Pos body[ROWS * COLS];  // depends on the display
-  size_t len;
-  volatile Dir dir;
+  Pos body[ROWS * COLS];  // ring buffer, depends on the display
+  cell_t head;            // index of the head segment in body
+  cell_t len;
+  Dir dir;
 } Snake;
 
 // Queue of directions
@@ -55,21 +111,21 @@ typedef struct {
 
 typedef enum { DIFF_EASY, DIFF_MEDIUM, DIFF_HARD } Difficulty;
 
-// Difficulty settings
+// Difficulty settings, periods in ms (multiples of LOGIC_TICK_MS)
 typedef struct {
   Difficulty name;
-  uint16_t move_T;       // the period for snake movement in game ticks
-  uint16_t food_T;       // the period for fruit spawning in game ticks
-  uint16_t evil_food_T;  // the period for evil fruit spawning in game ticks
+  uint16_t move_ms;       // the period for snake movement
+  uint16_t food_ms;       // the period for fruit spawning
+  uint16_t evil_food_ms;  // the period for evil fruit spawning
   uint8_t food_spawn_chance;  // the chance (in %) of spawning a fruit
   uint8_t
       evil_food_spawn_chance;  // the chance (in %) of spawning an evil fruit
   uint8_t max_fruit;           // maximum number of fruits on the field at once
   uint8_t max_evil_fruit;  // maximum number of evil fruits on the field at once
-  uint16_t fruit_ttl;      // time to live of a fruit in game ticks
-  uint16_t evil_fruit_ttl;  // time to live of an evil fruit in game ticks
-  size_t winning_len;       // length of the snake needed to win
-  size_t min_snake_len;     // minimum length of the snake, WARNING: must be <=
+  uint16_t fruit_ttl_ms;       // time to live of a fruit, counting its spawn tick
+  uint16_t evil_fruit_ttl_ms;  // time to live of an evil fruit
+  cell_t winning_len;       // length of the snake needed to win
+  cell_t min_snake_len;     // minimum length of the snake, WARNING: must be <=
                             // COLS
   uint8_t good_inc;         // how much the snake grows when eating a fruit
   uint8_t evil_dec;  // how much the snake shrinks when eating an evil fruit
@@ -78,38 +134,80 @@ typedef struct {
 // Fruit model
 typedef struct {
   Pos pos;
-  bool is_evil;
-  bool enabled;
-  uint16_t ttl;
+  bool is_evil;  // expiry is scheduled as EV_EXPIRE + slot
 } Fruit;
 
+// Pool of fruits, dense list of live slots plus a stack of free ones
+typedef struct {
+  Fruit slots[FRUIT_POOL_SIZE];
+  uint8_t active[FRUIT_POOL_SIZE];      // live slots, first active_count valid
+  uint8_t active_pos[FRUIT_POOL_SIZE];  // position of a live slot in active
+  uint8_t free[FRUIT_POOL_SIZE];        // free slots, first free_count valid
+  uint8_t active_count;
+  uint8_t free_count;
+} FruitPool;
+
 typedef enum { GAME_RUNNING, GAME_IDLE, GAME_WON, GAME_LOST } State;
 
+// Code game_tick runs: an entry of DIFFICULTIES compiled in as constants, or
+// the generic one reading GameManager.difficulty (any other settings)
+typedef enum { TICK_GENERIC, TICK_EASY, TICK_MEDIUM, TICK_HARD } TickKernel;
+
+// Scheduled game events, lower ids are handled first within a tick. Fruit
+// expiry has one event per pool slot.
+enum {
+  EV_MOVE,       // snake moves, every move_ms
+  EV_FOOD,       // fruit spawn roll, every food_ms
+  EV_EVIL_FOOD,  // evil fruit spawn roll, every evil_food_ms
+  EV_EXPIRE,     // + slot, fruit ttl ran out
+  SCHED_EVENTS = EV_EXPIRE + FRUIT_POOL_SIZE
+};
+#define SCHED_WHEEL_SIZE 64  // ticks per wheel turn, power of 2
+#define SCHED_NONE 0xFF      // end of a bucket list
+
+typedef enum { SCHED_IDLE, SCHED_ARMED, SCHED_FIRED } SchedState;
+
+// Timing wheel entry, every event has exactly one
+typedef struct {
+  uint32_t due;    // absolute tick
+  uint8_t next;    // bucket list links
+  uint8_t prev;
+  uint8_t state;   // SchedState
+} SchedNode;
+
+// Timing wheel of game ticks, events hash into bucket due % SCHED_WHEEL_SIZE
+typedef struct {
+  uint32_t now;  // logic ticks since the game started
+  uint8_t bucket[SCHED_WHEEL_SIZE];
+  SchedNode nodes[SCHED_EVENTS];
+} Scheduler;
+
 // Game model
 typedef struct {
   Snake snake;
-  volatile State state;
-  Dif difficulty;
-  Fruit fruits[ROWS * COLS];
-  size_t fruit_count;
-  size_t evil_fruit_count;
-  int buffered_len;
+  State state;
+  Dif difficulty;  // set through game_reset, it picks the tick kernel
+  uint8_t kernel;  // TickKernel of difficulty
+  FruitPool fruits;
+  uint8_t fruit_count;
+  uint8_t evil_fruit_count;
+  int16_t buffered_len;
+  uint32_t snake_occ[OCC_WORDS];  // bit per cell taken by the snake
+  uint32_t fruit_occ[OCC_WORDS];   // bit per cell taken by a fruit
+  uint8_t fruit_at[BOARD_CELLS];   // fruit slot + 1, 0 = no fruit
+  bool self_hit;                   // the last move ran into the body
+  Scheduler sched;                 // moves, spawn rolls and fruit expiry
+  uint32_t seed;                   // the game replays from it (record.h)
+  Rng rng;                         // fruit rolls, seeded by game_reset
+  cell_t dirty[GM_DIRTY_MAX];      // cells changed since the last draw
+  uint8_t dirty_count;
+  bool dirty_full;                 // too many changes or a new game
 } GameManager;
 
 // Constants (defined in models.c)
 extern const Dir DIR_DELTA[4];
 extern const Dif DIFFICULTIES[3];
-extern const rgb16_t SNAKE_COLOR;
-extern const rgb16_t SNAKE_HEAD_COLOR;
-extern const rgb16_t FRUIT_COLOR;
-extern const rgb16_t EVIL_FRUIT_COLOR;
-extern const rgb16_t TEXT_COLOR;
-extern const rgb16_t EASY_COLOR;
-extern const rgb16_t MEDIUM_COLOR;
-extern const rgb16_t HARD_COLOR;
-extern const rgb16_t SELECTED_COLOR;
-extern const rgb16_t LOST_COLOR;
-extern const rgb16_t WON_COLOR;
+extern const rgb16_t PALETTE[PALETTE_SIZE];
 extern const size_t MAX_GAME_ARRAY_LEN;
 extern const size_t MIN_GAME_ARRAY_LEN;
 #endif
\ No newline at end of file
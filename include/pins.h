@@ -0,0 +1,32 @@
+/**
+ * @file pins.h
+ * @brief GPIO assignment of the board (74HCT154 column decoder, buttons and
+ * the TLC5947 chain). Taken from main.c of the example project.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_PINS_H
+#define MY_PINS_H
+
+// ==== PINY 74HCT154 ====
+// Adresové vstupy: A = ADDR0, B = ADDR1, C = ADDR2, D = ADDR3
+#define HCT154_ADDR0 25
+#define HCT154_ADDR1 17
+#define HCT154_ADDR2 16
+#define HCT154_ADDR3 27
+// COL_EN = společné povolení výstupů (invertované řízení):
+//   HIGH = všechny sloupce vypnuté
+//   LOW  = dekodér aktivní, vybraný sloupec povolen
+#define HCT154_COL_EN 14
+// Buttons
+#define HTC154_SW1 22
+#define HTC154_SW2 21
+#define HTC154_SW3 26
+#define HTC154_SW4 4
+// ==== TLC5947 PINY ====
+#define TLC_MOSI 23
+#define TLC_SCLK 18
+#define TLC_XLAT 13
+#define TLC_BLANK 12
+
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @file record.h
+ * @brief Recording of games for bit-exact replays. The engine only depends on
+ * the seed given to game_reset and on the directions bound while running, so
+ * a game is stored as a header with the seed and a log of the logic tick and
+ * direction of every bound press.
+ *
+ * Layout, integers little-endian:
+ *   0  'S' 'R', version, difficulty, ROWS, COLS, LOGIC_RATE_HZ (u16)
+ *   8  seed (u32)
+ *  12  end tick, game_hash at the end (u32 each)
+ *  20  bytes of events (u16), end State, flags
+ *  24  events, each one (tick delta << 2 | direction) as a LEB128 varint
+ * The end fields stay 0 / GAME_RUNNING until the game is over.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_RECORD_H
+#define MY_RECORD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "models.h"
+
+#define REC_VERSION 3  // 2: xoshiro128** fruit rolls (rng.h), 3: fruit ttl
+#define REC_HEADER_BYTES 24
+#define REC_FLAG_TRUNCATED 0x01  // the log ran out of space, events are missing
+
+// Decoded header
+typedef struct {
+  Difficulty diff;
+  uint8_t rows, cols;
+  uint16_t rate_hz;
+  uint32_t seed;
+  uint32_t end_tick;
+  uint32_t end_hash;
+  uint16_t event_bytes;
+  State end_state;
+  uint8_t flags;
+} RecHeader;
+
+// Takes every finished recording, e.g. to store it on the host
+typedef void (*RecordSink)(const uint8_t *rec, size_t len);
+
+void record_init(uint8_t *buf, size_t cap);
+void record_set_sink(RecordSink sink);
+void record_start(const GameManager *gm);
+void record_event(uint32_t tick, Direction dir);
+void record_finish(const GameManager *gm);
+size_t record_get(const uint8_t **rec);
+void record_print(void);
+
+bool rec_parse_header(const uint8_t *rec, size_t len, RecHeader *out);
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file replay.h
+ * @brief Plays a recording (record.h) back through the engine, without the
+ * display or any timing: every logic tick feeds the presses logged for it
+ * and runs game_tick. The replay works on the GameManager and queue it is
+ * given, several can run side by side.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_REPLAY_H
+#define MY_REPLAY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "models.h"
+#include "record.h"
+
+typedef enum {
+  REPLAY_OK,        // playing, or finished as recorded
+  REPLAY_BAD,       // not a recording, corrupt, or of another build
+  REPLAY_DIVERGED,  // ended at another tick, state or hash than recorded
+} ReplayStatus;
+
+typedef struct {
+  RecHeader hdr;
+  const uint8_t *next;  // first undecoded event byte
+  const uint8_t *end;
+  uint32_t ev_tick;     // decoded event waiting for its tick
+  Direction ev_dir;
+  bool ev_pending;
+  bool done;            // the game ended or the log ran out
+  ReplayStatus status;
+  GameManager *gm;
+  Queue *queue;
+} Replay;
+
+ReplayStatus replay_open(Replay *rp, const uint8_t *rec, size_t len,
+                         GameManager *gm, Queue *queue);
+State replay_tick(Replay *rp);
+ReplayStatus replay_run(Replay *rp);
+uint32_t replay_now(const Replay *rp);
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file rng.h
+ * @brief Seedable pseudo random generator of the game, xoshiro128** (128 bits
+ * of state, period 2^128 - 1). It only needs 32-bit operations, so a number
+ * costs a few cycles on the ESP32 instead of a read of the hardware RNG
+ * register. The hardware RNG only seeds it (game_init).
+ *
+ * Streams: rng_jump advances a generator by 2^64 numbers, rng_split hands out
+ * the current stream and jumps past it, so generators split from one seed
+ * never overlap.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_RNG_H
+#define MY_RNG_H
+
+#include <stdint.h>
+
+typedef struct {
+  uint32_t s[4];  // never all zero
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+void rng_jump(Rng *rng);
+void rng_split(Rng *rng, Rng *stream);
+
+static inline uint32_t rng_rotl(uint32_t x, int k) {
+  return (x << k) | (x >> (32 - k));
+}
+
+/**
+ * @brief Next 32 random bits.
+ */
+static inline uint32_t rng_next(Rng *rng) {
+  uint32_t *s = rng->s;
+  uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+  uint32_t t = s[1] << 9;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rng_rotl(s[3], 11);
+  return result;
+}
+
+/**
+ * @brief Uniform number in [0, bound) without modulo bias (Lemire's
+ * multiply-and-shift, the rare biased low products are drawn again).
+ * @param bound Number of outcomes, 0 gives 0.
+ */
+static inline uint32_t rng_below(Rng *rng, uint32_t bound) {
+  uint64_t m = (uint64_t)rng_next(rng) * bound;
+  uint32_t low = (uint32_t)m;
+  if (low < bound) {
+    uint32_t threshold = -bound % bound;  // 2^32 mod bound
+    while (low < threshold) {
+      m = (uint64_t)rng_next(rng) * bound;
+      low = (uint32_t)m;
+    }
+  }
+  return (uint32_t)(m >> 32);
+}
+
+#endif
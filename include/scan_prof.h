@@ -0,0 +1,106 @@
+/**
+ * @file scan_prof.h
+ * @brief Cycle counter profile of the display scan: time per phase of a
+ * column step, wake-up latency after the alarm, period jitter and deadline
+ * overruns. A step costs a few cycle counter reads, so it stays enabled in
+ * production builds.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_SCAN_PROF_H
+#define MY_SCAN_PROF_H
+
+#include <stdint.h>
+
+#include "esp_attr.h"
+#include "esp_cpu.h"
+
+// 1 = profile every scan step, 0 = the hooks compile to nothing
+#ifndef SCAN_PROFILE
+#define SCAN_PROFILE 1
+#endif
+
+// Phases of a scan step, time goes to the phase that ends at a mark
+typedef enum {
+  SP_LOAD,   // load_column_into_tlc, the unpacked path only
+  SP_PACK,   // packing the column into the SPI frame, the unpacked path only
+  SP_SPI,    // SPI transfer (waiting for or starting it) and the latch
+  SP_GPIO,   // column blanking, address and enable
+  SP_FRAME,  // frame boundary: new frame, palette and prepacking
+  SP_PHASES
+} ScanPhase;
+
+// Snapshot of the counters, times in CPU cycles
+typedef struct {
+  uint32_t steps;     // scan steps profiled
+  uint32_t missed;    // alarms that came while the task was still busy
+  uint32_t overruns;  // steps that ran longer than the dwell
+  uint32_t late;      // periods longer than the dwell by more than 1/8
+  uint32_t period_min, period_max;  // between the starts of two steps
+  uint32_t wake_max;  // alarm to the start of the step
+  uint64_t wake_sum;
+  uint32_t busy_max;  // whole step
+  uint64_t busy_sum;
+  uint32_t phase_max[SP_PHASES];
+  uint64_t phase_sum[SP_PHASES];
+} ScanProfStats;
+
+// One step being measured, lives on the scan task stack
+typedef struct {
+  uint32_t start;  // cycle count at the start of the step
+  uint32_t last;   // at the last mark
+  uint32_t wake;   // alarm to start
+  uint32_t phase[SP_PHASES];
+} ScanProfRun;
+
+void scan_prof_init(uint32_t dwell_us);
+void scan_prof_commit(const ScanProfRun *run, uint32_t alarms);
+void scan_prof_reset(void);
+void scan_prof_get(ScanProfStats *out);
+void scan_prof_print(void);
+
+/**
+ * @brief Starts measuring a step.
+ * @param alarm_cycles Cycle count taken in the alarm ISR that woke the task.
+ */
+static inline void IRAM_ATTR scan_prof_begin(ScanProfRun *run,
+                                             uint32_t alarm_cycles) {
+#if SCAN_PROFILE
+  run->start = run->last = esp_cpu_get_cycle_count();
+  run->wake = run->start - alarm_cycles;
+  for (int i = 0; i < SP_PHASES; ++i) run->phase[i] = 0;
+#else
+  (void)run;
+  (void)alarm_cycles;
+#endif
+}
+
+/**
+ * @brief Charges the time since the last mark to a phase.
+ */
+static inline void IRAM_ATTR scan_prof_mark(ScanProfRun *run,
+                                            ScanPhase phase) {
+#if SCAN_PROFILE
+  uint32_t now = esp_cpu_get_cycle_count();
+  run->phase[phase] += now - run->last;
+  run->last = now;
+#else
+  (void)run;
+  (void)phase;
+#endif
+}
+
+/**
+ * @brief Finishes a step and adds it to the counters.
+ * @param alarms Alarms the task was woken for, more than 1 means missed ones.
+ */
+static inline void IRAM_ATTR scan_prof_end(ScanProfRun *run, uint32_t alarms) {
+#if SCAN_PROFILE
+  scan_prof_commit(run, alarms);
+#else
+  (void)run;
+  (void)alarms;
+#endif
+}
+
+#endif
@@ -0,0 +1,32 @@
+/**
+ * @file scheduler.h
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_SCHEDULER_H
+#define MY_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "models.h"
+
+void sched_init(Scheduler *sched);
+void sched_at(Scheduler *sched, uint8_t event, uint32_t delay);
+void sched_cancel(Scheduler *sched, uint8_t event);
+size_t sched_advance(Scheduler *sched, uint8_t *due);
+
+// Is the event waiting in the wheel
+static inline bool sched_pending(const Scheduler *sched, uint8_t event) {
+  return sched->nodes[event].state == SCHED_ARMED;
+}
+
+// Did the event fire on the current tick and was not cancelled or
+// rescheduled since, handlers of the same tick can drop later events
+static inline bool sched_fired(const Scheduler *sched, uint8_t event) {
+  return sched->nodes[event].state == SCHED_FIRED &&
+         sched->nodes[event].due == sched->now;
+}
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * @file screens.h
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef MY_SCREENS_H
+#define MY_SCREENS_H
+
+#include "models.h"
+
+// Ready-made frames of the screens that do not depend on the game (in flash)
+extern const color_t WON_SCREEN[ROWS][COLS];
+extern const color_t LOST_SCREEN[ROWS][COLS];
+extern const color_t IDLE_SCREENS[3][ROWS][COLS];  // by selected Difficulty
+
+#endif
@@ -16,8 +16,13 @@ extern "C" {
 
 
 // Počet řádků panelu (odpovídá počtu RGB trojic v jednom TLC5947)
+// Host builds may override both to run the game on a larger virtual board
+#ifndef ROWS
 #define ROWS 8
+#endif
+#ifndef COLS
 #define COLS 16
+#endif
 
 // Tyto tabulky definují mapování OUTx → barevná složka
 // Implementace (definice obsahu) je v main.c
@@ -29,11 +34,16 @@ typedef struct {
     spi_device_handle_t spi;
     gpio_num_t xlat_io;   // latch (XLAT)
     gpio_num_t blank_io;  // output enable / BLANK (active high)
+    uint32_t xlat_mask;   // xlat_io as a W1TS/W1TC register bit
+    uint32_t blank_mask;  // blank_io as a W1TS/W1TC register bit
     int chips;            // number of TLC5947 in chain
     int channels;         // chips * 24
     size_t frame_bytes;   // 36 * chips
     uint16_t *gs;         // [channels] 12-bit values
-    uint8_t  *tx;         // packed bitstream [frame_bytes]
+    uint8_t  *tx;         // packed bitstream [frame_bytes], DMA capable
+    spi_transaction_t trans; // in-flight pipelined transfer
+    bool shifting;        // trans was started and not yet waited for
+    bool bus_acquired;    // bus held by tlc5947_pipeline_begin
 } tlc5947_t;
 
 typedef struct {
@@ -69,12 +79,36 @@ void tlc5947_fill(tlc5947_t *dev, uint16_t value);
 /** Convert 8-bit to 12-bit s gamma≈2.2 (optional helper). */
 uint16_t tlc5947_u8_to_u12_gamma(uint8_t x);
 
+/** Pack the 12-bit channels into the wire bitstream (frame_bytes into out). */
+void tlc5947_pack(const tlc5947_t *dev, uint8_t *out);
+
 /** Push current buffer to TLC5947 chain over SPI and latch.
  *  If vblank_sync=true: BLANK↑ → XLAT↑ → (short delay) → BLANK↓.
  *  If false: pouze XLAT↑ (rychlejší, může krátce bliknout).
  */
 esp_err_t tlc5947_update(tlc5947_t *dev, bool vblank_sync);
 
+/** Same as tlc5947_update, but sends an already packed frame (frame_bytes
+ *  long, see tlc5947_pack) instead of packing dev->gs. */
+esp_err_t tlc5947_update_packed(tlc5947_t *dev, const uint8_t *tx,
+                                bool vblank_sync);
+
+/** Pulse XLAT to latch what was shifted in (BLANK-synced if vblank_sync). */
+void tlc5947_latch(const tlc5947_t *dev, bool vblank_sync);
+
+/** Pipelined mode: acquire the SPI bus for the whole session. */
+esp_err_t tlc5947_pipeline_begin(tlc5947_t *dev);
+
+/** Finish the pending transfer and release the bus. */
+void tlc5947_pipeline_end(tlc5947_t *dev);
+
+/** Start shifting a packed frame in the background (tx must be DMA capable
+ *  and stay valid until tlc5947_shift_wait). Outputs are not latched. */
+esp_err_t tlc5947_shift_start(tlc5947_t *dev, const uint8_t *tx);
+
+/** Wait until the frame started by tlc5947_shift_start is shifted in. */
+esp_err_t tlc5947_shift_wait(tlc5947_t *dev);
+
 /** Force BLANK level (true=outputs off). */
 void tlc5947_set_blank(const tlc5947_t *dev, bool blank);
 
@@ -6,9 +6,10 @@
 #ifndef MY_UTILSZ_H
 #define MY_UTILSZ_H
 #include "models.h"
+#include "rng.h"
 
-void insert_dir(Direction dir, GameManager *gm);
+void insert_dir(Queue *queue, Direction dir, GameManager *gm);
 bool conflictDir(Direction d, Direction last, GameManager *gm);
-int rand_range(int min, int max);
+int rand_range(Rng *rng, int min, int max);
 
 #endif
\ No newline at end of file
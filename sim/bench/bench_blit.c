@@ -0,0 +1,144 @@
+/**
+ * @file bench_blit.c
+ * @brief Blitter benchmarks on a large virtual board: checks sprites and text
+ * against a pixel by pixel reference (including clipping on every edge), then
+ * measures blit throughput and the cost of a scrolling text frame.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+#include "blit.h"
+#include "font.h"
+#include "models.h"
+
+static color_t fb[ROWS][COLS];
+static color_t ref_fb[ROWS][COLS];
+static uint8_t sprite_rows[32 * 4];
+
+// Pixel by pixel blit straight from the definition
+static void ref_blit(const Sprite *s, int x, int y, color_t color) {
+  int stride = (s->w + 7) / 8;
+  for (int r = 0; r < s->h; ++r) {
+    for (int c = 0; c < s->w; ++c) {
+      if (!(s->rows[r * stride + c / 8] & (0x80 >> (c % 8)))) continue;
+      int px = x + c, line = y + r;
+      if (px < 0 || px >= COLS || line < 0 || line >= ROWS) continue;
+      ref_fb[ROWS - 1 - line][px] = color;
+    }
+  }
+}
+
+static void ref_text(const char *text, int x, int y, color_t color) {
+  for (; *text; ++text, x += FONT_ADVANCE) {
+    char ch = *text;
+    if (ch >= 'a' && ch <= 'z') ch -= 'a' - 'A';
+    if (ch < FONT_FIRST || ch > FONT_LAST) continue;
+    Sprite g = {FONT_W, FONT_H, FONT_GLYPHS[ch - FONT_FIRST]};
+    ref_blit(&g, x, y, color);
+  }
+}
+
+static Sprite random_sprite(void) {
+  Sprite s = {(uint8_t)(1 + rand() % 32), (uint8_t)(1 + rand() % 32),
+              sprite_rows};
+  for (size_t i = 0; i < sizeof(sprite_rows); ++i) {
+    sprite_rows[i] = (uint8_t)rand();
+  }
+  return s;
+}
+
+static int check_blit(void) {
+  srand(3);
+  for (int i = 0; i < 20000; ++i) {
+    Sprite s = random_sprite();
+    int x = rand() % (COLS + 80) - 40;
+    int y = rand() % (ROWS + 80) - 40;
+    color_t color = (color_t)(1 + rand() % (PALETTE_SIZE - 1));
+    blit(fb, &s, x, y, color);
+    ref_blit(&s, x, y, color);
+    if (memcmp(fb, ref_fb, sizeof(fb)) != 0) return 1;
+  }
+  static const char *texts[] = {"LEN 30", "Hello, snake!", "0123456789",
+                                "a-z: ?!", ""};
+  for (int i = 0; i < 2000; ++i) {
+    const char *t = texts[rand() % 5];
+    int x = rand() % (COLS + 80) - 60;
+    int y = rand() % (ROWS + 10) - 5;
+    int end = text_draw(fb, t, x, y, TEXT_COLOR);
+    ref_text(t, x, y, TEXT_COLOR);
+    if (memcmp(fb, ref_fb, sizeof(fb)) != 0) return 1;
+    if (end != x + (int)strlen(t) * FONT_ADVANCE) return 1;
+  }
+  return 0;
+}
+
+// A long text scrolls by in width + COLS steps and ends off the panel
+static int check_scroll(void) {
+  const char *t = "THE QUICK BROWN FOX JUMPS OVER THE LAZY SNAKE";
+  TextScroll ts;
+  text_scroll_start(&ts, t, 0, TEXT_COLOR, 3);
+  int moves = 0, ticks = 0;
+  while (!text_scroll_done(&ts)) {
+    moves += text_scroll_tick(&ts);
+    ticks++;
+  }
+  return moves != text_width(t) + COLS || ticks != 3 * moves;
+}
+
+static void bench_sprites(int w, int h) {
+  const int rounds = 200000;
+  Sprite s = {(uint8_t)w, (uint8_t)h, sprite_rows};
+  memset(sprite_rows, 0xFF, sizeof(sprite_rows));
+  uint64_t start = bench_cycles();
+  for (int i = 0; i < rounds; ++i) {
+    blit(fb, &s, i % COLS - w / 2, i % ROWS - h / 2, SNAKE_COLOR);
+    bench_clobber(fb);
+  }
+  double cycles = (double)(bench_cycles() - start) / rounds;
+  printf("blit        %2dx%-2d solid  %8.1f cycles/sprite  %6.2f cycles/px\n",
+         w, h, cycles, cycles / (w * h));
+}
+
+static void bench_text(void) {
+  const int rounds = 100000;
+  const char *t = "SCORE 1234 LEN 56";
+  TextScroll ts;
+  text_scroll_start(&ts, t, (ROWS - FONT_H) / 2, TEXT_COLOR, 1);
+  uint64_t start = bench_cycles();
+  for (int i = 0; i < rounds; ++i) {
+    if (text_scroll_done(&ts)) {
+      text_scroll_start(&ts, t, (ROWS - FONT_H) / 2, TEXT_COLOR, 1);
+    }
+    text_scroll_tick(&ts);
+    text_scroll_draw(&ts, fb);
+    bench_clobber(fb);
+  }
+  double cycles = (double)(bench_cycles() - start) / rounds;
+  printf("text scroll %2d chars     %8.1f cycles/frame\n", (int)strlen(t),
+         cycles);
+}
+
+int main(void) {
+  printf("board %dx%d\n", ROWS, COLS);
+  if (check_blit()) {
+    fprintf(stderr, "blit diverged from the reference\n");
+    return 1;
+  }
+  printf("blit and text match the reference, clipped on every edge\n");
+  if (check_scroll()) {
+    fprintf(stderr, "text scroll took the wrong number of steps\n");
+    return 1;
+  }
+  printf("text scroll makes one pass in width + COLS steps\n");
+  bench_sprites(FONT_W, FONT_H);
+  bench_sprites(8, 8);
+  bench_sprites(32, 32);
+  bench_text();
+  return 0;
+}
+
+/*******************************EOF bench_blit.c******************************/
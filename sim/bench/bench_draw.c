@@ -0,0 +1,190 @@
+/**
+ * @file bench_draw.c
+ * @brief Running game renderer on a large virtual board: checks that the
+ * incremental draw_running matches a full redraw after every tick, then times
+ * both.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+#include "dir_queue.h"
+#include "draw.h"
+#include "frame_buffers.h"
+#include "fruit_pool.h"
+#include "game.h"
+#include "models.h"
+#include "screens.h"
+
+static Queue direction;
+
+static GameManager gm;
+static color_t ref_fb[ROWS][COLS];
+
+static const Dif PLAY = {.name = DIFF_EASY,
+                         .move_ms = LOGIC_TICK_MS,
+                         .food_ms = 2 * LOGIC_TICK_MS,
+                         .evil_food_ms = 3 * LOGIC_TICK_MS,
+                         .food_spawn_chance = 90,
+                         .evil_food_spawn_chance = 50,
+                         .max_fruit = 6,
+                         .max_evil_fruit = 4,
+                         .fruit_ttl_ms = 40 * LOGIC_TICK_MS,
+                         .evil_fruit_ttl_ms = 25 * LOGIC_TICK_MS,
+                         .winning_len = ROWS * COLS,
+                         .min_snake_len = 4,
+                         .good_inc = 3,
+                         .evil_dec = 2};
+
+// The original full redraw
+static void ref_draw(void) {
+  memset(ref_fb, BLACK_COLOR, sizeof(ref_fb));
+  for (size_t i = 0; i < gm.snake.len; i++) {
+    Pos *seg = snake_segment(&gm.snake, i);
+    ref_fb[seg->r][seg->c] = SNAKE_COLOR;
+  }
+  Pos *head = snake_segment(&gm.snake, 0);
+  ref_fb[head->r][head->c] = SNAKE_HEAD_COLOR;
+  for (size_t i = 0; i < fruit_pool_count(&gm.fruits); i++) {
+    Fruit *fruit = fruit_pool_active(&gm.fruits, i);
+    ref_fb[fruit->pos.r][fruit->pos.c] =
+        fruit->is_evil ? EVIL_FRUIT_COLOR : FRUIT_COLOR;
+  }
+}
+
+static void play_turn(void) {
+  if (rand() % 3 == 0) {
+    Direction turn = (Direction)(rand() % 4);
+    if (turn != gm.snake.dir.opposite) queue_push(&direction, turn);
+  }
+  if (game_tick(&gm, &direction) != GAME_RUNNING) {
+    if (rand() % 2) draw_lost(&gm);  // another screen in between
+    fb_acquire();
+    game_reset(&gm, &PLAY, rng_next(&gm.rng));
+    queue_clear(&direction);
+  }
+}
+
+/**
+ * @brief Random play with a varying number of frame boundaries between two
+ * draws, comparing every drawn frame with a full redraw and checking that the
+ * scanner picks up the newest one.
+ */
+static int check_draw(void) {
+  srand(5);
+  fb_init();
+  draw_init();
+  game_reset(&gm, &PLAY, BENCH_SEED);
+  queue_clear(&direction);
+  for (int step = 0; step < 100000; ++step) {
+    color_t(*drawn)[COLS] = fb_draw;  // fb_draw moves on when published
+    draw_running(&gm);
+    ref_draw();
+    if (memcmp(drawn, ref_fb, sizeof(ref_fb)) != 0) return 1;
+    // the scanner may reach several or no frame boundaries per tick
+    int boundaries = rand() % 3;
+    for (int i = 0; i < boundaries; ++i) fb_acquire();
+    // the scanner always switches to the newest frame
+    if (boundaries && memcmp(fb_display, ref_fb, sizeof(ref_fb)) != 0) return 1;
+    play_turn();
+  }
+  return 0;
+}
+
+/**
+ * @brief The prepared screens are published once per change of the state or
+ * the difficulty, not on every tick.
+ */
+static int check_screens(void) {
+  fb_init();
+  draw_init();
+  FbStats st;
+  uint32_t expected = 0;
+  for (int d = DIFF_EASY; d <= DIFF_HARD; ++d) {
+    game_set_difficulty(&gm, &DIFFICULTIES[d]);
+    for (int i = 0; i < 100; ++i) draw_idle(&gm);
+    expected++;
+  }
+  for (int i = 0; i < 30; ++i) draw_won(&gm);  // within the 2 s hold
+  expected++;
+  fb_get_stats(&st);
+  if (st.published != expected) return 1;
+  fb_acquire();
+  return memcmp(fb_display, WON_SCREEN, sizeof(WON_SCREEN)) != 0;
+}
+
+static bool display_has(color_t color) {
+  for (int r = 0; r < ROWS; ++r) {
+    if (memchr(fb_display[r], color, COLS)) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief The lost screen gives way to the final length after the hold and
+ * comes back once the text is done.
+ */
+static int check_end_text(void) {
+  fb_init();
+  draw_init();
+  gm.snake.len = 30;
+  int ticks = 0;
+  do {
+    draw_lost(&gm);
+    fb_acquire();
+    if (++ticks > 100) return 1;  // the hold is 40 ticks
+  } while (memcmp(fb_display, LOST_SCREEN, sizeof(LOST_SCREEN)) == 0);
+  if (!display_has(LOST_COLOR)) return 1;
+  do {
+    draw_lost(&gm);
+    fb_acquire();
+    if (++ticks > 2000) return 1;
+  } while (memcmp(fb_display, LOST_SCREEN, sizeof(LOST_SCREEN)) != 0);
+  return 0;
+}
+
+static void bench_draw(bool full) {
+  const int rounds = 20000;
+  srand(9);
+  game_reset(&gm, &PLAY, BENCH_SEED);
+  queue_clear(&direction);
+  uint64_t total = 0;
+  for (int i = 0; i < rounds; ++i) {
+    if (full) fb_invalidate();
+    uint64_t start = bench_cycles();
+    draw_running(&gm);
+    total += bench_cycles() - start;
+    bench_clobber(fb_display);
+    fb_acquire();  // frame boundary of the scan
+    play_turn();
+  }
+  printf("draw_running %-12s %8.1f cycles/frame\n", full ? "full" : "incremental",
+         (double)total / rounds);
+}
+
+int main(void) {
+  printf("board %dx%d\n", ROWS, COLS);
+  if (check_draw()) {
+    fprintf(stderr, "incremental draw diverged from a full redraw\n");
+    return 1;
+  }
+  printf("incremental draw matches a full redraw\n");
+  if (check_screens()) {
+    fprintf(stderr, "prepared screens published more than once\n");
+    return 1;
+  }
+  printf("prepared screens published once per change\n");
+  if (check_end_text()) {
+    fprintf(stderr, "final length did not show between the end screens\n");
+    return 1;
+  }
+  printf("final length shows between the end screens\n");
+  bench_draw(true);
+  bench_draw(false);
+  return 0;
+}
+
+/*******************************EOF bench_draw.c******************************/
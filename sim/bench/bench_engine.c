@@ -0,0 +1,486 @@
+/**
+ * @file bench_engine.c
+ * @brief Engine benchmarks on a large virtual board (ROWS/COLS are set by the
+ * build). Each optimised routine is first checked against a reference.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <stdbool.h>
+
+#include "bench_util.h"
+#include "dir_queue.h"
+#include "fruit_pool.h"
+#include "game.h"
+#include "models.h"
+#include "rng.h"
+#include "scheduler.h"
+#include "utils.h"
+
+static Queue direction;
+
+static GameManager gm;
+static Pos ref_body[ROWS * COLS];
+static size_t ref_len;
+
+// The original move: shift the whole body one slot, then move the head
+static void ref_move(Direction dir, int len_change) {
+  if (len_change > 0 && ref_len < ROWS * COLS) ref_len++;
+  if (len_change < 0 && ref_len > 0) ref_len--;
+  for (size_t i = ref_len - 1; i > 0; i--) ref_body[i] = ref_body[i - 1];
+  ref_body[0].r = (ref_body[0].r + DIR_DELTA[dir].pos.r + ROWS) % ROWS;
+  ref_body[0].c = (ref_body[0].c + DIR_DELTA[dir].pos.c + COLS) % COLS;
+}
+
+// Lays out a snake of len cells in a serpentine starting at (0,0)
+static void snake_setup(size_t len) {
+  memset(&gm, 0, sizeof(gm));
+  rng_seed(&gm.rng, BENCH_SEED);
+  game_set_difficulty(&gm, &DIFFICULTIES[DIFF_EASY]);
+  gm.snake.dir = DIR_DELTA[DIR_RIGHT];
+  gm.snake.len = len;
+  for (size_t i = 0; i < len; ++i) {
+    size_t cell = len - 1 - i;
+    int r = (int)(cell / COLS);
+    int c = (int)(cell % COLS);
+    if (r & 1) c = COLS - 1 - c;
+    *snake_segment(&gm.snake, i) = (Pos){r, c};
+    ref_body[i] = (Pos){r, c};
+  }
+  ref_len = len;
+  queue_clear(&direction);
+  fruit_pool_init(&gm.fruits);
+  occupancy_rebuild(&gm);
+}
+
+// Difficulty that keeps the board busy: spawn rolls every tick, short ttl
+static const Dif BUSY = {.name = DIFF_EASY,
+                         .move_ms = LOGIC_TICK_MS,
+                         .food_ms = LOGIC_TICK_MS,
+                         .evil_food_ms = LOGIC_TICK_MS,
+                         .food_spawn_chance = 100,
+                         .evil_food_spawn_chance = 100,
+                         .max_fruit = 6,
+                         .max_evil_fruit = 4,
+                         .fruit_ttl_ms = 40 * LOGIC_TICK_MS,
+                         .evil_fruit_ttl_ms = 25 * LOGIC_TICK_MS,
+                         .winning_len = ROWS * COLS,
+                         .min_snake_len = 1,
+                         .good_inc = 3,
+                         .evil_dec = 2};
+
+// Brute force self-collision, the original collision_detected
+static bool ref_collision(void) {
+  Pos head = *snake_segment(&gm.snake, 0);
+  for (size_t i = 1; i < gm.snake.len; i++) {
+    if (is_collision(&head, snake_segment(&gm.snake, i))) return true;
+  }
+  return false;
+}
+
+// Brute force fruit lookup, the original food_eaten scan (without removal)
+static bool ref_fruit_at_head(void) {
+  Pos head = *snake_segment(&gm.snake, 0);
+  for (size_t i = 0; i < fruit_pool_count(&gm.fruits); i++) {
+    if (is_collision(&head, &fruit_pool_active(&gm.fruits, i)->pos)) return true;
+  }
+  return false;
+}
+
+// Every live fruit has its expiry pending and no free slot has one
+static bool expiry_consistent(void) {
+  bool live[FRUIT_POOL_SIZE] = {false};
+  for (size_t i = 0; i < fruit_pool_count(&gm.fruits); ++i) {
+    live[gm.fruits.active[i]] = true;
+  }
+  for (size_t slot = 0; slot < FRUIT_POOL_SIZE; ++slot) {
+    if (live[slot] != sched_pending(&gm.sched, EV_EXPIRE + slot)) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Random play with busy fruit spawning, checks after every tick that
+ * the incremental occupancy bitmap and fruit index equal a fresh rebuild,
+ * that the lookups agree with the brute force scans and that every live fruit
+ * has its expiry scheduled.
+ */
+static int check_occupancy(void) {
+  static GameManager copy;
+  srand(11);
+  game_reset(&gm, &BUSY, BENCH_SEED);
+  queue_clear(&direction);
+  for (int step = 0; step < 100000; ++step) {
+    if (rand() % 3 == 0) {
+      Direction turn = (Direction)(rand() % 4);
+      if (turn != gm.snake.dir.opposite) queue_push(&direction, turn);
+    }
+    State res = game_tick(&gm, &direction);
+    if (collision_detected(&gm) != ref_collision()) return 1;
+    if (res != GAME_RUNNING || gm.snake.len < 2) {
+      game_reset(&gm, &BUSY, rng_next(&gm.rng));
+      queue_clear(&direction);
+      continue;
+    }
+    size_t head = cell_index(*snake_segment(&gm.snake, 0));
+    // fruits never spawn under the snake, so one under the head got eaten
+    if (ref_fruit_at_head() || gm.fruit_at[head] != 0) return 1;
+    if (!expiry_consistent()) return 1;
+
+    copy = gm;
+    occupancy_rebuild(&copy);
+    if (memcmp(copy.snake_occ, gm.snake_occ, sizeof(gm.snake_occ)) != 0 ||
+        memcmp(copy.fruit_at, gm.fruit_at, sizeof(gm.fruit_at)) != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Spawns a fruit every food_T ticks on a snake that does not get to
+ * move and checks the live count against a per-tick ttl countdown: a fruit
+ * spawned on tick s is gone after tick s + ttl - 1.
+ */
+static int check_expiry(uint16_t food_T, uint16_t ttl) {
+  Dif d = BUSY;
+  d.move_ms = UINT16_MAX;  // first move long after the check
+  d.food_ms = food_T * LOGIC_TICK_MS;
+  d.fruit_ttl_ms = ttl * LOGIC_TICK_MS;
+  d.food_spawn_chance = 101;  // rand_range(0, 100) is always below
+  d.evil_food_spawn_chance = 0;
+  d.max_fruit = FRUIT_POOL_SIZE;
+  game_reset(&gm, &d, BENCH_SEED);
+  for (uint32_t t = 1; t < 20u * ttl; ++t) {
+    game_tick(&gm, &direction);
+    size_t expected = 0;
+    for (uint32_t s = food_T; s <= t; s += food_T) {
+      if (t < s + ttl - 1) expected++;
+    }
+    if (gm.fruit_count != expected || !expiry_consistent()) return 1;
+  }
+  return 0;
+}
+
+static void bench_lookup(size_t len) {
+  const int rounds = 20000;
+  snake_setup(len);
+  volatile bool sink = false;
+  uint64_t start = bench_ns();
+  for (int i = 0; i < rounds; ++i) sink = ref_collision() || ref_fruit_at_head();
+  double ref_ns = (double)(bench_ns() - start) / rounds;
+  start = bench_ns();
+  for (int i = 0; i < rounds; ++i) {
+    sink = collision_detected(&gm) ||
+           gm.fruit_at[cell_index(*snake_segment(&gm.snake, 0))] != 0;
+  }
+  double occ_ns = (double)(bench_ns() - start) / rounds;
+  (void)sink;
+  printf("hit tests   len %6zu  %10.1f ns (scan)   %8.1f ns\n", len, ref_ns,
+         occ_ns);
+}
+
+static int check_move(void) {
+  srand(7);
+  snake_setup(16);
+  for (int step = 0; step < 200000; ++step) {
+    Direction dir = gm.snake.dir.name;
+    if (rand() % 4 == 0) {
+      Direction turn = (Direction)(rand() % 4);
+      if (turn != DIR_DELTA[dir].opposite) dir = turn;
+    }
+    int change = rand() % 8 == 0 ? 1 : (rand() % 8 == 0 ? -1 : 0);
+    if (gm.snake.len <= 2 && change < 0) change = 0;
+    gm.buffered_len = change;
+    queue_push(&direction, dir);
+    move_snake(&gm, &direction);
+    ref_move(dir, change);
+    if (gm.snake.len != ref_len) return 1;
+    for (size_t i = 0; i < ref_len; ++i) {
+      Pos *seg = snake_segment(&gm.snake, i);
+      if (seg->r != ref_body[i].r || seg->c != ref_body[i].c) return 1;
+    }
+  }
+  return 0;
+}
+
+static void bench_move(size_t len) {
+  const int moves = 200000;
+  snake_setup(len);
+  uint64_t start = bench_ns();
+  for (int i = 0; i < moves; ++i) move_snake(&gm, &direction);
+  double ring_ns = (double)(bench_ns() - start) / moves;
+  bench_clobber(&gm);
+
+  start = bench_ns();
+  for (int i = 0; i < moves; ++i) ref_move(DIR_RIGHT, 0);
+  double ref_ns = (double)(bench_ns() - start) / moves;
+  bench_clobber(ref_body);
+  printf("move_snake  len %6zu  %10.1f ns (shift)  %8.1f ns\n", len, ref_ns,
+         ring_ns);
+}
+
+// The original rejection sampler: up to 1000 random cells, each one checked
+// against every snake segment and fruit slot
+static Pos ref_get_pos(bool *valid) {
+  bool found = false;
+  int max_attempts = 1000;
+  Pos new_pos = {0, 0};
+  while (!found && max_attempts--) {
+    new_pos.r = rand_range(&gm.rng, 0, ROWS - 1);
+    new_pos.c = rand_range(&gm.rng, 0, COLS - 1);
+    found = true;
+    for (size_t i = 0; i < gm.snake.len && found; ++i) {
+      if (is_collision(&new_pos, snake_segment(&gm.snake, i))) found = false;
+    }
+    for (size_t i = 0; i < fruit_pool_count(&gm.fruits) && found; ++i) {
+      if (is_collision(&new_pos, &fruit_pool_active(&gm.fruits, i)->pos)) {
+        found = false;
+      }
+    }
+  }
+  *valid = found;
+  return new_pos;
+}
+
+/**
+ * @brief Checks that get_pos only returns free cells, picks every free cell
+ * about equally often and reports a full board exactly.
+ */
+static int check_get_pos(void) {
+  enum { FREE = 64, DRAWS = 2000 };
+  static unsigned hits[ROWS * COLS];
+  bool valid;
+  snake_setup(ROWS * COLS - FREE);
+  memset(hits, 0, sizeof(hits));
+  for (int i = 0; i < FREE * DRAWS; ++i) {
+    Pos p = get_pos(&gm, &valid);
+    if (!valid || occ_test(gm.snake_occ, cell_index(p))) return 1;
+    hits[cell_index(p)]++;
+  }
+  for (size_t cell = 0; cell < ROWS * COLS; ++cell) {
+    if (occ_test(gm.snake_occ, cell)) continue;
+    if (hits[cell] < DRAWS * 85 / 100 || hits[cell] > DRAWS * 115 / 100) return 1;
+  }
+
+  snake_setup(ROWS * COLS - 1);  // exactly one free cell
+  Pos p = get_pos(&gm, &valid);
+  if (!valid || p.r != (ROWS - 1) || occ_test(gm.snake_occ, cell_index(p))) return 1;
+  snake_setup(ROWS * COLS);  // full board
+  get_pos(&gm, &valid);
+  return valid ? 1 : 0;
+}
+
+static void bench_get_pos(unsigned occupancy_pct) {
+  const int ref_rounds = 20, rounds = 20000;
+  snake_setup((size_t)ROWS * COLS * occupancy_pct / 100);
+  bool valid;
+  int ref_failed = 0;
+  uint64_t start = bench_ns();
+  for (int i = 0; i < ref_rounds; ++i) {
+    ref_get_pos(&valid);
+    ref_failed += !valid;
+  }
+  double ref_ns = (double)(bench_ns() - start) / ref_rounds;
+  start = bench_ns();
+  for (int i = 0; i < rounds; ++i) {
+    get_pos(&gm, &valid);
+    bench_clobber(&valid);
+  }
+  double rank_ns = (double)(bench_ns() - start) / rounds;
+  printf("get_pos     occ %5u%%  %10.1f ns (reject, %d/%d failed)  %8.1f ns\n",
+         occupancy_pct, ref_ns, ref_failed, ref_rounds, rank_ns);
+}
+
+/**
+ * @brief Checks the generator against an independent computation of the
+ * jump (the 2^64-th power of the xoshiro128** step as a GF(2) matrix) and
+ * the bounded range against the modulo bias it replaces.
+ */
+static int check_rng(void) {
+  static const uint32_t jumped[4] = {0x78d283ee, 0x5d6f623e, 0xcabe44b7,
+                                     0x2ce0ca9e};
+  Rng rng, stream;
+  rng_seed(&rng, 1);
+  rng_split(&rng, &stream);
+  if (rng_next(&stream) != 0x650941ba) return 1;  // stream starts at the seed
+  for (int i = 0; i < 4; ++i) {
+    if (rng.s[i] != jumped[i]) return 1;
+  }
+  // bound 3 * 2^30: modulo maps a quarter of all words onto the first
+  // third, which then comes up half of the time instead of a third
+  enum { DRAWS = 1 << 20 };
+  const uint32_t bound = 3u << 30;
+  unsigned low = 0, low_mod = 0;
+  rng_seed(&rng, BENCH_SEED);
+  for (int i = 0; i < DRAWS; ++i) {
+    low += rng_below(&rng, bound) < (1u << 30);
+    low_mod += rng_next(&rng) % bound < (1u << 30);
+  }
+  printf("rng         first third of 3*2^30: %.3f unbiased, %.3f modulo\n",
+         (double)low / DRAWS, (double)low_mod / DRAWS);
+  return low < DRAWS / 3 - DRAWS / 100 || low > DRAWS / 3 + DRAWS / 100;
+}
+
+static void bench_rng(void) {
+  const int rounds = 10000000;
+  Rng rng;
+  rng_seed(&rng, BENCH_SEED);
+  uint32_t sum = 0;
+  uint64_t start = bench_ns();
+  for (int i = 0; i < rounds; ++i) sum += (uint32_t)rand_range(&rng, 0, 100);
+  double range_ns = (double)(bench_ns() - start) / rounds;
+  start = bench_ns();
+  for (int i = 0; i < 1000; ++i) rng_jump(&rng);
+  double jump_ns = (double)(bench_ns() - start) / 1000;
+  bench_clobber(&sum);
+  printf("rand_range  %10.1f ns/call  rng_jump %8.1f ns\n", range_ns, jump_ns);
+}
+
+// Turns for the kernel runs, DIR_EMPTY = no press on that tick
+enum { KERNEL_TICKS = 1 << 20 };
+static uint8_t turns[KERNEL_TICKS];
+
+static void turns_setup(void) {
+  Rng rng;
+  rng_seed(&rng, BENCH_SEED);
+  for (size_t i = 0; i < KERNEL_TICKS; ++i) {
+    turns[i] = rng_below(&rng, 8) == 0 ? (uint8_t)rng_below(&rng, 4) : DIR_EMPTY;
+  }
+}
+
+/**
+ * @brief Plays the scripted turns on the game, new games start from seeds of
+ * the same stream, so two runs of a difficulty play identical games.
+ * @param generic Force the generic tick kernel.
+ * @param other Game to compare with, NULL for none. A divergence persists in
+ * the rng and timers, so comparing every few ticks is enough.
+ * @return Ticks until a state differed from other, KERNEL_TICKS if none did.
+ */
+static size_t kernel_run(GameManager *g, Queue *q, const Dif *d, bool generic,
+                         GameManager *other, Queue *other_q) {
+  Rng seeds;
+  rng_seed(&seeds, BENCH_SEED);
+  game_reset(g, d, rng_next(&seeds));
+  queue_clear(q);
+  if (generic) g->kernel = TICK_GENERIC;
+  if (other != NULL) {
+    game_reset(other, d, g->seed);
+    queue_clear(other_q);
+  }
+  for (size_t i = 0; i < KERNEL_TICKS; ++i) {
+    if (turns[i] != DIR_EMPTY) insert_dir(q, (Direction)turns[i], g);
+    if (game_tick(g, q) != GAME_RUNNING) {
+      game_reset(g, d, rng_next(&seeds));
+      queue_clear(q);
+      if (generic) g->kernel = TICK_GENERIC;
+    }
+    if (other != NULL) {
+      if (turns[i] != DIR_EMPTY) insert_dir(other_q, (Direction)turns[i], other);
+      if (game_tick(other, other_q) != GAME_RUNNING) {
+        game_reset(other, d, g->seed);
+        queue_clear(other_q);
+      }
+      if (i % 64 == 0 && game_hash(g) != game_hash(other)) return i;
+    }
+  }
+  return KERNEL_TICKS;
+}
+
+/**
+ * @brief Checks that every specialised kernel plays exactly like the generic
+ * one and that a changed entry falls back to the generic kernel.
+ */
+static int check_kernels(void) {
+  static GameManager specialised;
+  static Queue q, sq;
+  turns_setup();
+  for (int d = DIFF_EASY; d <= DIFF_HARD; ++d) {
+    if (tick_kernel_for(&DIFFICULTIES[d]) != (TickKernel)(TICK_EASY + d)) return 1;
+    if (kernel_run(&gm, &q, &DIFFICULTIES[d], true, &specialised, &sq) !=
+        KERNEL_TICKS) {
+      return 1;
+    }
+  }
+  Dif custom = DIFFICULTIES[DIFF_MEDIUM];
+  custom.good_inc++;
+  return tick_kernel_for(&custom) != TICK_GENERIC;
+}
+
+static void bench_kernels(void) {
+  static const char *const names[3] = {"easy", "medium", "hard"};
+  static Queue q;
+  for (int d = DIFF_EASY; d <= DIFF_HARD; ++d) {
+    uint64_t start = bench_ns();
+    kernel_run(&gm, &q, &DIFFICULTIES[d], true, NULL, NULL);
+    double generic_ns = (double)(bench_ns() - start) / KERNEL_TICKS;
+    start = bench_ns();
+    kernel_run(&gm, &q, &DIFFICULTIES[d], false, NULL, NULL);
+    double kernel_ns = (double)(bench_ns() - start) / KERNEL_TICKS;
+    printf("game_tick   %-6s  %10.1f ns (generic)  %8.1f ns (kernel)\n",
+           names[d], generic_ns, kernel_ns);
+  }
+}
+
+// Game ticks of the given difficulty, resets when the straight run ends
+static void bench_tick(const char *name, const Dif *d) {
+  const int rounds = 200000;
+  game_reset(&gm, d, BENCH_SEED);
+  queue_clear(&direction);
+  uint64_t start = bench_ns();
+  for (int i = 0; i < rounds; ++i) {
+    if (game_tick(&gm, &direction) != GAME_RUNNING) game_reset(&gm, d, rng_next(&gm.rng));
+  }
+  double tick_ns = (double)(bench_ns() - start) / rounds;
+  printf("game_tick   %-6s  %10.1f ns/tick\n", name, tick_ns);
+}
+
+int main(void) {
+  printf("board %dx%d\n", ROWS, COLS);
+  if (check_move()) {
+    fprintf(stderr, "move_snake diverged from the reference\n");
+    return 1;
+  }
+  printf("move_snake matches the reference\n");
+  if (check_occupancy()) {
+    fprintf(stderr, "occupancy bitmap diverged from the snake/fruits\n");
+    return 1;
+  }
+  printf("occupancy bitmap consistent\n");
+  if (check_get_pos()) {
+    fprintf(stderr, "get_pos is not uniform over the free cells\n");
+    return 1;
+  }
+  printf("get_pos uniform over free cells, full board reported\n");
+  // the second ttl spans several turns of the timing wheel
+  if (check_expiry(5, 7) || check_expiry(8, 60)) {
+    fprintf(stderr, "fruit expiry diverged from the ttl countdown\n");
+    return 1;
+  }
+  printf("fruit expiry matches the ttl countdown\n");
+  if (check_rng()) {
+    fprintf(stderr, "rng diverged from the reference jump or is biased\n");
+    return 1;
+  }
+  printf("rng jump matches the reference, range unbiased\n");
+  if (check_kernels()) {
+    fprintf(stderr, "a tick kernel diverged from the generic one\n");
+    return 1;
+  }
+  printf("tick kernels match the generic tick\n");
+  static const size_t lens[] = {4, 128, 1024, ROWS * COLS};
+  for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) bench_move(lens[i]);
+  for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) bench_lookup(lens[i]);
+  bench_get_pos(50);
+  bench_get_pos(95);
+  bench_get_pos(99);
+  bench_rng();
+  bench_tick("busy", &BUSY);
+  bench_kernels();
+  return 0;
+}
+
+/******************************EOF bench_engine.c*****************************/
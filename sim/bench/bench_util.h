@@ -0,0 +1,46 @@
+/**
+ * @file bench_util.h
+ * @brief Timing helpers shared by the host benchmarks.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_BENCH_UTIL_H
+#define SIM_BENCH_UTIL_H
+
+#include <stdint.h>
+#include <time.h>
+
+// Seed of the games the benchmarks play, so every run plays the same ones
+#define BENCH_SEED 1
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @brief Reads the CPU cycle counter, falls back to nanoseconds on hosts
+ * without one.
+ */
+static inline uint64_t bench_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Monotonic wall clock in nanoseconds.
+ */
+static inline uint64_t bench_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Keeps the optimiser from dropping work whose result is otherwise unused
+static inline void bench_clobber(const void *p) { __asm__ volatile("" : : "g"(p) : "memory"); }
+
+#endif
@@ -0,0 +1,62 @@
+/**
+ * @file bot.c
+ * @brief Implementation of the greedy player. It only reads the game it is
+ * given, any number of games can be played side by side.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "bot.h"
+
+#include <stdlib.h>
+
+#include "fruit_pool.h"
+#include "game.h"
+
+// Shortest distance between two coordinates on a wrapping axis
+static int wrap_dist(int a, int b, int size) {
+  int d = abs(a - b);
+  return d < size - d ? d : size - d;
+}
+
+/**
+ * @brief Checks whether the cell is taken by the snake, ignoring the tail which
+ * moves away in the same step.
+ */
+static bool cell_blocked(GameManager *gm, Pos p) {
+  for (size_t i = 0; i + 1 < gm->snake.len; ++i) {
+    Pos *seg = snake_segment(&gm->snake, i);
+    if (seg->r == p.r && seg->c == p.c) return true;
+  }
+  return false;
+}
+
+/**
+ * @brief Picks the safe direction that gets closest to the nearest good fruit.
+ */
+Direction bot_choose(GameManager *gm) {
+  Pos head = *snake_segment(&gm->snake, 0);
+  Direction best = gm->snake.dir.name;
+  int best_score = -1;
+  for (int d = DIR_UP; d <= DIR_RIGHT; ++d) {
+    if (d == (int)gm->snake.dir.opposite) continue;
+    Pos next = {(head.r + DIR_DELTA[d].pos.r + ROWS) % ROWS,
+                (head.c + DIR_DELTA[d].pos.c + COLS) % COLS};
+    int score = cell_blocked(gm, next) ? 0 : 1000;
+    int nearest = ROWS + COLS;
+    for (size_t i = 0; i < fruit_pool_count(&gm->fruits); ++i) {
+      Fruit *fruit = fruit_pool_active(&gm->fruits, i);
+      if (fruit->is_evil) continue;
+      int dist = wrap_dist(next.r, fruit->pos.r, ROWS) +
+                 wrap_dist(next.c, fruit->pos.c, COLS);
+      if (dist < nearest) nearest = dist;
+    }
+    score += ROWS + COLS - nearest;
+    if (score > best_score) {
+      best_score = score;
+      best = (Direction)d;
+    }
+  }
+  return best;
+}
+
+/*********************************EOF bot.c*********************************/
@@ -0,0 +1,15 @@
+/**
+ * @file bot.h
+ * @brief Greedy player shared by the simulator and the tuner: heads for the
+ * nearest good fruit and avoids running into its own body.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_BOT_H
+#define SIM_BOT_H
+
+#include "models.h"
+
+Direction bot_choose(GameManager *gm);
+
+#endif
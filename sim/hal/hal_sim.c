@@ -0,0 +1,514 @@
+/**
+ * @file hal_sim.c
+ * @brief Host implementation of the ESP-IDF subset used by the firmware. Time
+ * is virtual: FreeRTOS tasks are coroutines run by priority until they block,
+ * then the clock jumps to the next timer or wake-up, so the game and scan
+ * loops run headless at full host speed.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "hal_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include "driver/gpio.h"
+#include "driver/gptimer.h"
+#include "driver/spi_master.h"
+#include "esp_cpu.h"
+#include "esp_random.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "soc/gpio_reg.h"
+#include "soc/soc.h"
+
+#define SIM_MAX_TIMERS 8
+#define SIM_MAX_TASKS 8
+#define SIM_TASK_STACK (256 * 1024)  // host stacks, the firmware sizes are tiny
+#define SIM_NEVER INT64_MAX
+
+struct sim_timer {
+  esp_timer_cb_t cb;
+  void *arg;
+  gptimer_alarm_cb_t alarm_cb;  // set for a gptimer, runs as its ISR
+  uint32_t resolution_hz;
+  uint64_t alarm_count;
+  int64_t alarm_us;
+  bool auto_reload;
+  const char *name;
+  int64_t period;
+  int64_t next_due;
+  bool active;
+  uint64_t calls;
+  uint64_t host_ns;  // host time spent inside the callback
+};
+
+struct sim_task {
+  ucontext_t ctx;
+  TaskFunction_t fn;
+  void *arg;
+  const char *name;
+  UBaseType_t prio;
+  int64_t wake_us;   // ready from then on, SIM_NEVER = waits for a notify
+  uint32_t notify;   // pending notification count
+  bool notify_wait;  // blocked in ulTaskNotifyTake
+  uint64_t runs;     // times the task was resumed
+  uint64_t host_ns;  // host time spent running the task
+};
+
+struct sim_spi_device {
+  spi_host_device_t host;
+  int clock_hz;
+  bool bus_acquired;
+  bool polling;  // a polling transaction was started and not yet ended
+};
+
+typedef struct {
+  gpio_isr_t handler;
+  void *arg;
+} sim_isr_t;
+
+static struct sim_timer timers[SIM_MAX_TIMERS];
+static size_t timer_count = 0;
+static int64_t now_us = 0;
+static int64_t end_us = 0;
+static struct sim_task tasks[SIM_MAX_TASKS];
+static size_t task_count = 0;
+static struct sim_task *current = NULL;  // running task, NULL = scheduler
+static ucontext_t sched_ctx;
+static struct timespec run_t0;  // host time the running task or callback began
+static uint32_t last_cycles;    // keeps the cycle counter monotonic
+static uint32_t rng_state = 0x12345678u;
+static uint8_t pin_level[GPIO_NUM_MAX];
+static sim_isr_t isr[GPIO_NUM_MAX];
+static hal_sim_stats_t stats;
+static hal_sim_pin_hook_t pin_hook = NULL;
+
+// ==== SIMULATOR CONTROL ====
+void hal_sim_seed(uint32_t seed) { rng_state = seed ? seed : 0x12345678u; }
+
+const hal_sim_stats_t *hal_sim_stats(void) { return &stats; }
+
+size_t hal_sim_timer_count(void) { return timer_count; }
+
+bool hal_sim_timer_info(size_t i, const char **name, uint64_t *calls,
+                        uint64_t *host_ns) {
+  if (i >= timer_count) return false;
+  if (name) *name = timers[i].name;
+  if (calls) *calls = timers[i].calls;
+  if (host_ns) *host_ns = timers[i].host_ns;
+  return true;
+}
+
+void hal_sim_set_pin_hook(hal_sim_pin_hook_t hook) { pin_hook = hook; }
+
+bool hal_sim_fire_isr_by_arg(void *arg) {
+  for (size_t i = 0; i < GPIO_NUM_MAX; ++i) {
+    if (isr[i].handler && isr[i].arg == arg) {
+      isr[i].handler(isr[i].arg);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t hal_sim_task_count(void) { return task_count; }
+
+bool hal_sim_task_info(size_t i, const char **name, uint64_t *runs,
+                       uint64_t *host_ns) {
+  if (i >= task_count) return false;
+  if (name) *name = tasks[i].name;
+  if (runs) *runs = tasks[i].runs;
+  if (host_ns) *host_ns = tasks[i].host_ns;
+  return true;
+}
+
+static uint64_t host_ns_since(const struct timespec *t0) {
+  struct timespec t1;
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  return (uint64_t)((t1.tv_sec - t0->tv_sec) * 1000000000LL +
+                    (t1.tv_nsec - t0->tv_nsec));
+}
+
+// Fires every timer due at now_us, in creation order
+static void fire_timers(void) {
+  for (size_t i = 0; i < timer_count; ++i) {
+    struct sim_timer *t = &timers[i];
+    if (!t->active || t->next_due != now_us) continue;
+    if (t->period > 0) {
+      t->next_due += t->period;
+    } else {
+      t->active = false;  // one-shot alarm
+    }
+    stats.timer_fires++;
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    run_t0 = t0;
+    if (t->alarm_cb) {
+      gptimer_alarm_event_data_t ev = {.count_value = t->alarm_count,
+                                       .alarm_value = t->alarm_count};
+      t->alarm_cb(t, &ev, t->arg);
+    } else {
+      t->cb(t->arg);
+    }
+    t->calls++;
+    t->host_ns += host_ns_since(&t0);
+  }
+}
+
+// Highest priority task that is ready now, the first created on a tie
+static struct sim_task *next_ready(void) {
+  struct sim_task *best = NULL;
+  for (size_t i = 0; i < task_count; ++i) {
+    if (tasks[i].wake_us > now_us) continue;
+    if (best == NULL || tasks[i].prio > best->prio) best = &tasks[i];
+  }
+  return best;
+}
+
+// Earliest timer or task wake-up after now_us
+static int64_t next_event(void) {
+  int64_t next = SIM_NEVER;
+  for (size_t i = 0; i < timer_count; ++i) {
+    if (timers[i].active && timers[i].next_due < next) next = timers[i].next_due;
+  }
+  for (size_t i = 0; i < task_count; ++i) {
+    if (tasks[i].wake_us < next) next = tasks[i].wake_us;
+  }
+  return next;
+}
+
+// Gives the CPU back to the scheduler until the task is ready again
+static void task_block(int64_t wake_us) {
+  if (current == NULL) {
+    fprintf(stderr, "hal_sim: blocking call outside a task\n");
+    abort();
+  }
+  current->wake_us = wake_us;
+  swapcontext(&current->ctx, &sched_ctx);
+}
+
+static void task_trampoline(void) {
+  current->fn(current->arg);
+  // FreeRTOS tasks must not return, treat it as deleting itself
+  current->wake_us = SIM_NEVER;
+  current->notify = 0;
+  swapcontext(&current->ctx, &sched_ctx);
+}
+
+static void main_task(void *arg) { ((void (*)(void))arg)(); }
+
+void hal_sim_run(void (*entry)(void), int64_t duration_us) {
+  end_us = now_us + duration_us;
+  xTaskCreatePinnedToCore(main_task, "main", 0, (void *)entry, 1, NULL, 0);
+  while (1) {
+    struct sim_task *task = next_ready();
+    if (task == NULL) {
+      int64_t next = next_event();
+      if (next >= end_us) break;
+      now_us = next;
+      fire_timers();
+      continue;
+    }
+    struct timespec t0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    run_t0 = t0;
+    current = task;
+    task->runs++;
+    swapcontext(&sched_ctx, &task->ctx);
+    current = NULL;
+    task->host_ns += host_ns_since(&t0);
+  }
+  now_us = end_us;
+}
+
+// ==== esp_timer ====
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args,
+                           esp_timer_handle_t *out_handle) {
+  if (args == NULL || out_handle == NULL) return ESP_ERR_INVALID_ARG;
+  if (timer_count >= SIM_MAX_TIMERS) return ESP_ERR_NO_MEM;
+  struct sim_timer *t = &timers[timer_count++];
+  *t = (struct sim_timer){.cb = args->callback, .arg = args->arg,
+                          .name = args->name};
+  *out_handle = t;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+  if (timer == NULL || period == 0) return ESP_ERR_INVALID_ARG;
+  timer->period = (int64_t)period;
+  timer->next_due = now_us + (int64_t)period;
+  timer->active = true;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (timer == NULL || !timer->active) return ESP_ERR_INVALID_STATE;
+  timer->active = false;
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time(void) { return now_us; }
+
+// ==== gptimer ====
+esp_err_t gptimer_new_timer(const gptimer_config_t *config,
+                            gptimer_handle_t *ret_timer) {
+  if (config == NULL || ret_timer == NULL || config->resolution_hz == 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer_count >= SIM_MAX_TIMERS) return ESP_ERR_NO_MEM;
+  struct sim_timer *t = &timers[timer_count++];
+  *t = (struct sim_timer){.name = "gptimer",
+                          .resolution_hz = config->resolution_hz};
+  *ret_timer = t;
+  return ESP_OK;
+}
+
+esp_err_t gptimer_register_event_callbacks(gptimer_handle_t timer,
+                                           const gptimer_event_callbacks_t *cbs,
+                                           void *user_data) {
+  if (timer == NULL || cbs == NULL) return ESP_ERR_INVALID_ARG;
+  timer->alarm_cb = cbs->on_alarm;
+  timer->arg = user_data;
+  return ESP_OK;
+}
+
+esp_err_t gptimer_set_alarm_action(gptimer_handle_t timer,
+                                   const gptimer_alarm_config_t *config) {
+  if (timer == NULL || config == NULL) return ESP_ERR_INVALID_ARG;
+  // the virtual clock counts microseconds
+  int64_t us = (int64_t)(config->alarm_count * 1000000u / timer->resolution_hz);
+  if (us == 0) return ESP_ERR_INVALID_ARG;
+  timer->alarm_count = config->alarm_count;
+  timer->alarm_us = us;
+  timer->auto_reload = config->flags.auto_reload_on_alarm;
+  return ESP_OK;
+}
+
+esp_err_t gptimer_enable(gptimer_handle_t timer) {
+  return timer ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gptimer_start(gptimer_handle_t timer) {
+  if (timer == NULL || timer->active || timer->alarm_us == 0) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->period = timer->auto_reload ? timer->alarm_us : 0;
+  timer->next_due = now_us + timer->alarm_us;
+  timer->active = true;
+  return ESP_OK;
+}
+
+// ==== FreeRTOS ====
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack_depth, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *out_handle,
+                                   BaseType_t core) {
+  (void)stack_depth;
+  (void)core;  // one host thread, priorities decide the order
+  if (fn == NULL || task_count >= SIM_MAX_TASKS) return pdFALSE;
+  struct sim_task *t = &tasks[task_count++];
+  *t = (struct sim_task){.fn = fn, .arg = arg, .name = name, .prio = prio,
+                         .wake_us = now_us};
+  getcontext(&t->ctx);
+  t->ctx.uc_stack.ss_sp = malloc(SIM_TASK_STACK);
+  t->ctx.uc_stack.ss_size = SIM_TASK_STACK;
+  t->ctx.uc_link = NULL;
+  if (t->ctx.uc_stack.ss_sp == NULL) abort();
+  makecontext(&t->ctx, task_trampoline, 0);
+  if (out_handle) *out_handle = t;
+  // a higher priority task starts right away, as it would preempt the caller
+  if (current && prio > current->prio) task_block(now_us);
+  return pdPASS;
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return (TickType_t)(now_us / (1000000 / configTICK_RATE_HZ));
+}
+
+void vTaskDelay(TickType_t ticks) {
+  task_block(now_us + (int64_t)ticks * (1000000 / configTICK_RATE_HZ));
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *prev_wake, TickType_t increment) {
+  *prev_wake += increment;
+  int64_t wake = (int64_t)*prev_wake * (1000000 / configTICK_RATE_HZ);
+  if (wake <= now_us) return pdFALSE;  // already late, no delay
+  task_block(wake);
+  return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+  if (current->notify == 0 && ticks_to_wait != 0) {
+    current->notify_wait = true;
+    task_block(ticks_to_wait == portMAX_DELAY
+                   ? SIM_NEVER
+                   : now_us + (int64_t)ticks_to_wait *
+                                  (1000000 / configTICK_RATE_HZ));
+    current->notify_wait = false;
+  }
+  uint32_t count = current->notify;
+  if (count) current->notify = clear_on_exit ? 0 : count - 1;
+  return count;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken) {
+  task->notify++;
+  if (task->notify_wait && task->wake_us > now_us) task->wake_us = now_us;
+  if (woken) *woken = pdTRUE;  // ISRs run between tasks, the switch is free
+}
+
+// ==== ROM / RNG / CPU ====
+void esp_rom_delay_us(uint32_t us) { stats.rom_delay_us += us; }
+
+uint32_t esp_rom_get_cpu_ticks_per_us(void) { return SIM_CPU_MHZ; }
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void) {
+  uint64_t host = host_ns_since(&run_t0) * SIM_CPU_MHZ / 1000;
+  uint32_t cycles = (uint32_t)((uint64_t)now_us * SIM_CPU_MHZ + host);
+  // a callback and the task it wakes restart the host part at the same
+  // virtual time, never let the count run backwards
+  if ((int32_t)(cycles - last_cycles) < 0) cycles = last_cycles;
+  last_cycles = cycles;
+  return cycles;
+}
+
+uint32_t esp_random(void) {
+  // xorshift32, good enough for a reproducible stand-in
+  uint32_t x = rng_state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  rng_state = x;
+  return x;
+}
+
+// ==== GPIO ====
+esp_err_t gpio_config(const gpio_config_t *cfg) {
+  if (cfg == NULL) return ESP_ERR_INVALID_ARG;
+  return ESP_OK;
+}
+
+// Every output change goes through here, so the hook sees all edges in order
+static void drive_pin(int pin, int level) {
+  if (pin_level[pin] == level) return;
+  pin_level[pin] = (uint8_t)level;
+  if (pin_hook) pin_hook(pin, level);
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+  if ((unsigned)gpio_num >= GPIO_NUM_MAX) return ESP_ERR_INVALID_ARG;
+  stats.gpio_writes++;
+  drive_pin(gpio_num, level ? 1 : 0);
+  return ESP_OK;
+}
+
+// Pins are driven in ascending order within one register write
+void hal_sim_reg_write(uint32_t addr, uint32_t value) {
+  int level;
+  if (addr == GPIO_OUT_W1TS_REG) {
+    level = 1;
+  } else if (addr == GPIO_OUT_W1TC_REG) {
+    level = 0;
+  } else {
+    fprintf(stderr, "hal_sim: write to unmodelled register 0x%08x\n", addr);
+    abort();
+  }
+  stats.reg_writes++;
+  for (int pin = 0; pin < 32; ++pin) {
+    if (value & (1u << pin)) drive_pin(pin, level);
+  }
+}
+
+int gpio_get_level(gpio_num_t gpio_num) {
+  if ((unsigned)gpio_num >= GPIO_NUM_MAX) return 0;
+  return pin_level[gpio_num];
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags) {
+  (void)intr_alloc_flags;
+  return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler,
+                               void *args) {
+  if ((unsigned)gpio_num >= GPIO_NUM_MAX) return ESP_ERR_INVALID_ARG;
+  isr[gpio_num] = (sim_isr_t){.handler = isr_handler, .arg = args};
+  return ESP_OK;
+}
+
+// ==== SPI ====
+esp_err_t spi_bus_initialize(spi_host_device_t host,
+                             const spi_bus_config_t *bus_config, int dma_chan) {
+  (void)host;
+  (void)dma_chan;
+  return bus_config ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host,
+                             const spi_device_interface_config_t *dev_config,
+                             spi_device_handle_t *handle) {
+  if (dev_config == NULL || handle == NULL) return ESP_ERR_INVALID_ARG;
+  struct sim_spi_device *dev = calloc(1, sizeof(*dev));
+  if (dev == NULL) return ESP_ERR_NO_MEM;
+  dev->host = host;
+  dev->clock_hz = dev_config->clock_speed_hz;
+  *handle = dev;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+  free(handle);
+  return ESP_OK;
+}
+
+static void spi_count(const spi_transaction_t *trans_desc) {
+  stats.spi_transfers++;
+  stats.spi_bytes += (trans_desc->length + 7) / 8;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t handle,
+                              spi_transaction_t *trans_desc) {
+  if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+  if (handle->polling) return ESP_ERR_INVALID_STATE;
+  spi_count(trans_desc);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_start(spi_device_handle_t handle,
+                                   spi_transaction_t *trans_desc,
+                                   TickType_t ticks_to_wait) {
+  (void)ticks_to_wait;
+  if (handle == NULL || trans_desc == NULL) return ESP_ERR_INVALID_ARG;
+  if (handle->polling) return ESP_ERR_INVALID_STATE;
+  handle->polling = true;
+  spi_count(trans_desc);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_end(spi_device_handle_t handle,
+                                 TickType_t ticks_to_wait) {
+  (void)ticks_to_wait;
+  if (handle == NULL) return ESP_ERR_INVALID_ARG;
+  if (!handle->polling) return ESP_ERR_INVALID_STATE;
+  handle->polling = false;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait) {
+  (void)wait;
+  if (device == NULL) return ESP_ERR_INVALID_ARG;
+  device->bus_acquired = true;
+  return ESP_OK;
+}
+
+void spi_device_release_bus(spi_device_handle_t dev) {
+  if (dev) dev->bus_acquired = false;
+}
+
+/*******************************EOF hal_sim.c*******************************/
@@ -0,0 +1,22 @@
+/**
+ * @file esp_check.h
+ * @brief Host stand-in for the ESP-IDF argument checking macros.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_ESP_CHECK_H
+#define SIM_ESP_CHECK_H
+
+#include <stdio.h>
+
+#include "esp_err.h"
+
+#define ESP_RETURN_ON_FALSE(a, err_code, log_tag, format, ...)      \
+  do {                                                              \
+    if (!(a)) {                                                     \
+      fprintf(stderr, "%s: " format "\n", log_tag, ##__VA_ARGS__); \
+      return err_code;                                              \
+    }                                                               \
+  } while (0)
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * @file esp_cpu.h
+ * @brief Host stand-in for the CPU cycle counter. Cycles follow the virtual
+ * clock at SIM_CPU_MHZ plus the host time spent since the running task or
+ * callback started, so periods stay exact and work is measured on the host.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_ESP_CPU_H
+#define SIM_ESP_CPU_H
+
+#include <stdint.h>
+
+#define SIM_CPU_MHZ 240
+
+typedef uint32_t esp_cpu_cycle_count_t;
+
+esp_cpu_cycle_count_t esp_cpu_get_cycle_count(void);
+
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file esp_heap_caps.h
+ * @brief Host stand-in for the capability-aware heap. Every host allocation
+ * counts as DMA capable.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_ESP_HEAP_CAPS_H
+#define SIM_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA (1u << 3)
+#define MALLOC_CAP_8BIT (1u << 2)
+#define MALLOC_CAP_INTERNAL (1u << 11)
+
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) {
+  (void)caps;
+  return malloc(size);
+}
+
+static inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+  (void)caps;
+  return calloc(n, size);
+}
+
+static inline void heap_caps_free(void *ptr) { free(ptr); }
+
+#endif
@@ -0,0 +1,14 @@
+/**
+ * @file esp_random.h
+ * @brief Host stand-in for the hardware RNG, seeded by the simulator.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_ESP_RANDOM_H
+#define SIM_ESP_RANDOM_H
+
+#include <stdint.h>
+
+uint32_t esp_random(void);
+
+#endif
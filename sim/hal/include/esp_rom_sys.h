@@ -0,0 +1,16 @@
+/**
+ * @file esp_rom_sys.h
+ * @brief Host stand-in for the ROM busy-wait and clock helpers.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_ESP_ROM_SYS_H
+#define SIM_ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+// Busy waits are only counted, the virtual clock is not advanced.
+void esp_rom_delay_us(uint32_t us);
+uint32_t esp_rom_get_cpu_ticks_per_us(void);
+
+#endif
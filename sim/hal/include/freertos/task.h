@@ -0,0 +1,31 @@
+/**
+ * @file task.h
+ * @brief Host stand-in for the FreeRTOS task API. Tasks are coroutines on
+ * the simulator virtual clock, a blocked task lets the clock run on to the
+ * next timer or wake-up. Core affinity is accepted and ignored.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_FREERTOS_TASK_H
+#define SIM_FREERTOS_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct sim_task *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *arg);
+
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name,
+                                   uint32_t stack_depth, void *arg,
+                                   UBaseType_t prio, TaskHandle_t *out_handle,
+                                   BaseType_t core);
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t *prev_wake, TickType_t increment);
+#define vTaskDelayUntil(prev_wake, increment) \
+  ((void)xTaskDelayUntil((prev_wake), (increment)))
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken);
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file hal_sim.h
+ * @brief Control interface of the host HAL shim used by the simulator.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_HAL_SIM_H
+#define SIM_HAL_SIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "driver/gpio.h"
+
+// Counters collected by the shim while the firmware runs
+typedef struct {
+  uint64_t gpio_writes;     // gpio_set_level calls
+  uint64_t reg_writes;      // GPIO W1TS/W1TC register writes
+  uint64_t spi_transfers;   // completed SPI transactions
+  uint64_t spi_bytes;       // bytes shifted out over SPI
+  uint64_t rom_delay_us;    // busy waits requested by the firmware
+  uint64_t timer_fires;     // esp_timer callbacks executed
+} hal_sim_stats_t;
+
+/**
+ * @brief Seeds the esp_random stand-in so runs are reproducible.
+ */
+void hal_sim_seed(uint32_t seed);
+
+/**
+ * @brief Runs entry (normally app_main) as the main task until the virtual
+ * clock reaches duration_us. Ready tasks run by priority, timers fire in due
+ * order, as fast as the host allows.
+ */
+void hal_sim_run(void (*entry)(void), int64_t duration_us);
+
+/**
+ * @brief Fires the GPIO interrupt handler registered with the given argument.
+ * @return false if no such handler was registered.
+ */
+bool hal_sim_fire_isr_by_arg(void *arg);
+
+const hal_sim_stats_t *hal_sim_stats(void);
+
+// Called on every change of an output level, in the order they happen
+typedef void (*hal_sim_pin_hook_t)(int pin, int level);
+void hal_sim_set_pin_hook(hal_sim_pin_hook_t hook);
+
+size_t hal_sim_timer_count(void);
+
+/**
+ * @brief Reports how often timer i fired and how much host time its callback
+ * used in total.
+ * @return false if i is out of range.
+ */
+bool hal_sim_timer_info(size_t i, const char **name, uint64_t *calls,
+                        uint64_t *host_ns);
+
+size_t hal_sim_task_count(void);
+
+/**
+ * @brief Reports how often task i was resumed and how much host time it ran
+ * in total.
+ * @return false if i is out of range.
+ */
+bool hal_sim_task_info(size_t i, const char **name, uint64_t *runs,
+                       uint64_t *host_ns);
+
+#endif
@@ -0,0 +1,17 @@
+/**
+ * @file soc.h
+ * @brief Host stand-in for the register access macros. Writes are routed to
+ * the simulator, which models the registers the firmware touches.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_SOC_SOC_H
+#define SIM_SOC_SOC_H
+
+#include <stdint.h>
+
+void hal_sim_reg_write(uint32_t addr, uint32_t value);
+
+#define REG_WRITE(addr, value) hal_sim_reg_write((uint32_t)(addr), (uint32_t)(value))
+
+#endif
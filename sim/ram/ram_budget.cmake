@@ -0,0 +1,65 @@
+# Sums the static RAM (.data and .bss symbols) of the given objects or
+# archives, prints the largest symbols and fails when BUDGET bytes are
+# exceeded. Works on the host build and on the firmware ELF alike:
+#   cmake -DNM=xtensa-esp32-elf-nm -DFILES=build/imp.elf -DBUDGET=... \
+#         -P sim/ram/ram_budget.cmake
+# Inputs: NM, FILES (list), BUDGET (bytes, 0 = report only), TOP (symbols).
+if(NOT NM OR NOT FILES)
+  message(FATAL_ERROR "ram_budget: NM and FILES are required")
+endif()
+if(NOT DEFINED BUDGET)
+  set(BUDGET 0)
+endif()
+if(NOT DEFINED TOP)
+  set(TOP 15)
+endif()
+
+execute_process(COMMAND ${NM} -S ${FILES}
+                OUTPUT_VARIABLE nm_out RESULT_VARIABLE nm_res)
+if(NOT nm_res EQUAL 0)
+  message(FATAL_ERROR "ram_budget: ${NM} failed")
+endif()
+
+string(REPLACE "\n" ";" nm_lines "${nm_out}")
+set(total 0)
+set(symbols "")
+foreach(line IN LISTS nm_lines)
+  # <address> <size> <type> <name>, b/B = .bss, d/D = .data
+  if(line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) ([bBdD]) (.+)$")
+    set(size_hex ${CMAKE_MATCH_1})
+    set(name ${CMAKE_MATCH_3})
+    math(EXPR size "0x${size_hex}")
+    math(EXPR total "${total} + ${size}")
+    # the zero padded hex size sorts as a string
+    string(LENGTH "${size_hex}" width)
+    math(EXPR pad "16 - ${width}")
+    string(REPEAT "0" ${pad} zeros)
+    list(APPEND symbols "${zeros}${size_hex} ${size} ${name}")
+  endif()
+endforeach()
+
+list(SORT symbols ORDER DESCENDING)
+list(LENGTH symbols count)
+if(count GREATER TOP)
+  list(SUBLIST symbols 0 ${TOP} symbols)
+endif()
+message("static RAM by symbol (largest ${TOP} of ${count}):")
+foreach(entry IN LISTS symbols)
+  string(REGEX REPLACE "^[0-9a-fA-F]+ ([0-9]+) (.+)$" "\\1;\\2" parts "${entry}")
+  list(GET parts 0 size)
+  list(GET parts 1 name)
+  string(LENGTH "${size}" width)
+  math(EXPR pad "8 - ${width}")
+  string(REPEAT " " ${pad} spaces)
+  message("  ${spaces}${size}  ${name}")
+endforeach()
+
+if(BUDGET GREATER 0)
+  message("static RAM total ${total} of ${BUDGET} bytes")
+  if(total GREATER BUDGET)
+    message(FATAL_ERROR "static RAM over budget by "
+                        "${total} - ${BUDGET} bytes")
+  endif()
+else()
+  message("static RAM total ${total} bytes")
+endif()
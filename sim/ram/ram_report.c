@@ -0,0 +1,33 @@
+/**
+ * @file ram_report.c
+ * @brief Prints the size of the game models and framebuffers for the board
+ * this is built for (ROWS/COLS), the per-symbol static RAM comes from
+ * ram_budget.cmake.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stdio.h>
+
+#include "frame_buffers.h"
+#include "models.h"
+
+#define ROW(type) printf("  %-18s %8zu\n", #type, sizeof(type))
+
+int main(void) {
+  printf("models of a %dx%d board (%d cells):\n", ROWS, COLS, BOARD_CELLS);
+  ROW(Pos);
+  ROW(Fruit);
+  ROW(Dif);
+  ROW(Snake);
+  ROW(FruitPool);
+  ROW(Scheduler);
+  ROW(GameManager);
+  ROW(Queue);
+  printf("  %-18s %8zu  (x%d in fb_bufs)\n", "framebuffer",
+         sizeof(color_t[ROWS][COLS]), FB_COUNT);
+  printf("  %-18s %8zu  (heap, packed columns, a TLC5947 per 8 rows)\n",
+         "col_tx", (size_t)COLS * 36 * ((ROWS + 7) / 8));
+  return 0;
+}
+
+/******************************EOF ram_report.c******************************/
@@ -0,0 +1,74 @@
+/**
+ * @file rec_file.c
+ * @brief Reading and writing the text form of recordings.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "rec_file.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int hex_val(int c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Decodes the hex digits of a line into a new entry, 0 on success
+static int add_entry(RecFile *file, const char *hex) {
+  size_t digits = strspn(hex, "0123456789abcdefABCDEF");
+  if (digits == 0 || digits % 2) return 1;
+  RecEntry *recs = realloc(file->recs, (file->count + 1) * sizeof(*recs));
+  if (recs == NULL) return 1;
+  file->recs = recs;
+  RecEntry *e = &recs[file->count];
+  e->len = digits / 2;
+  e->data = malloc(e->len);
+  if (e->data == NULL) return 1;
+  for (size_t i = 0; i < e->len; ++i) {
+    e->data[i] = (uint8_t)(hex_val(hex[2 * i]) << 4 | hex_val(hex[2 * i + 1]));
+  }
+  file->count++;
+  return 0;
+}
+
+/**
+ * @brief Reads every recording of a file.
+ * @return 0 on success, the recordings are in out.
+ */
+int rec_file_load(const char *path, RecFile *out) {
+  *out = (RecFile){0};
+  FILE *f = fopen(path, "r");
+  if (f == NULL) return 1;
+  char *line = NULL;
+  size_t cap = 0;
+  int err = 0;
+  while (!err && getline(&line, &cap, f) != -1) {
+    if (strncmp(line, "rec ", 4) != 0) continue;
+    if (strncmp(line + 4, "     ", 5) == 0) continue;  // "nothing recorded"
+    err = add_entry(out, line + 4);
+  }
+  free(line);
+  fclose(f);
+  if (err) rec_file_free(out);
+  return err;
+}
+
+void rec_file_free(RecFile *file) {
+  for (size_t i = 0; i < file->count; ++i) free(file->recs[i].data);
+  free(file->recs);
+  *file = (RecFile){0};
+}
+
+/**
+ * @brief Appends a recording as a "rec <hex>" line.
+ */
+void rec_file_write(FILE *f, const uint8_t *rec, size_t len) {
+  fputs("rec ", f);
+  for (size_t i = 0; i < len; ++i) fprintf(f, "%02x", rec[i]);
+  fputc('\n', f);
+}
+
+/******************************EOF rec_file.c*******************************/
@@ -0,0 +1,30 @@
+/**
+ * @file rec_file.h
+ * @brief Files of recordings: one "rec <hex>" line per game, as printed by
+ * record_print on the console. Other lines are ignored, so a captured serial
+ * log can be used as it is.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_REC_FILE_H
+#define SIM_REC_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct {
+  uint8_t *data;
+  size_t len;
+} RecEntry;
+
+typedef struct {
+  RecEntry *recs;
+  size_t count;
+} RecFile;
+
+int rec_file_load(const char *path, RecFile *out);
+void rec_file_free(RecFile *file);
+void rec_file_write(FILE *f, const uint8_t *rec, size_t len);
+
+#endif
@@ -0,0 +1,218 @@
+/**
+ * @file replay_main.c
+ * @brief Headless replay of recorded games (record.h) through the firmware
+ * engine at full host speed. Checks that every complete recording ends as
+ * recorded, that seeking from keyframes lands on the same state as playing
+ * from the start, and with --bench times the engine on the recordings.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench_util.h"
+#include "game.h"
+#include "models.h"
+#include "rec_file.h"
+#include "replay.h"
+
+#define KEYFRAME_TICKS 256  // default spacing of the keyframes
+
+static bool force_generic;  // --generic, replay on the generic tick kernel
+
+// Starts a replay, on the kernel game_reset picked unless --generic
+static ReplayStatus open_replay(Replay *rp, const RecEntry *e, GameManager *gm,
+                                Queue *queue) {
+  ReplayStatus st = replay_open(rp, e->data, e->len, gm, queue);
+  if (force_generic) gm->kernel = TICK_GENERIC;
+  return st;
+}
+
+// Complete copy of a replay at a tick, enough to continue from there
+typedef struct {
+  GameManager gm;
+  Queue queue;
+  Replay rp;
+} Keyframe;
+
+typedef struct {
+  Keyframe *frames;  // frames[i] is at tick i * every
+  size_t count;
+  uint32_t every;
+} Keyframes;
+
+static void keyframe_take(Keyframes *kf, const Replay *rp) {
+  Keyframe *frames = realloc(kf->frames, (kf->count + 1) * sizeof(*frames));
+  if (frames == NULL) return;  // seeking then starts further back
+  kf->frames = frames;
+  Keyframe *k = &frames[kf->count++];
+  k->gm = *rp->gm;
+  k->queue = *rp->queue;
+  k->rp = *rp;
+}
+
+// Restores the last keyframe not after tick and plays on up to it
+static void seek(const Keyframes *kf, uint32_t tick, Replay *rp,
+                 GameManager *gm, Queue *queue) {
+  size_t i = tick / kf->every;
+  if (i >= kf->count) i = kf->count - 1;
+  const Keyframe *k = &kf->frames[i];
+  *gm = k->gm;
+  *queue = k->queue;
+  *rp = k->rp;
+  rp->gm = gm;
+  rp->queue = queue;
+  while (!rp->done && replay_now(rp) < tick) replay_tick(rp);
+}
+
+static const char *status_name(ReplayStatus st) {
+  switch (st) {
+    case REPLAY_OK:
+      return "ok";
+    case REPLAY_DIVERGED:
+      return "DIVERGED";
+    default:
+      return "BAD";
+  }
+}
+
+/**
+ * @brief Replays one recording with keyframes, then checks a seek.
+ * @param seek_tick Tick to seek to, UINT32_MAX for the middle of the game.
+ * @return 0 if the replay and the seek matched.
+ */
+static int check_recording(size_t n, const RecEntry *e, uint32_t every,
+                           uint32_t seek_tick) {
+  static const char *const diffs[3] = {"easy", "medium", "hard"};
+  static GameManager gm, seek_gm;
+  static Queue queue, seek_queue;
+  Replay rp, seek_rp;
+  if (open_replay(&rp, e, &gm, &queue) != REPLAY_OK) {
+    printf("rec %3zu  BAD (not a recording of this build)\n", n);
+    return 1;
+  }
+  Keyframes kf = {.every = every};
+  while (!rp.done) {
+    if (replay_now(&rp) % every == 0) keyframe_take(&kf, &rp);
+    replay_tick(&rp);
+  }
+  const RecHeader *h = &rp.hdr;
+  printf("rec %3zu  %-6s seed %08lx  %6lu ticks  %4u event bytes  len %3u  %s%s  %s\n",
+         n, diffs[h->diff], (unsigned long)h->seed,
+         (unsigned long)replay_now(&rp), h->event_bytes, (unsigned)gm.snake.len,
+         gm.state == GAME_WON ? "won" : gm.state == GAME_LOST ? "lost" : "open",
+         h->flags & REC_FLAG_TRUNCATED ? " (truncated)" : "",
+         status_name(rp.status));
+  int failed = rp.status != REPLAY_OK;
+
+  // seeking must land on the state playing from the start reaches
+  uint32_t end = replay_now(&rp);
+  uint32_t target = seek_tick == UINT32_MAX ? end / 2 : seek_tick;
+  if (target > end) target = end;
+  if (!failed && kf.count > 0) {
+    seek(&kf, target, &seek_rp, &seek_gm, &seek_queue);
+    uint32_t sought = game_hash(&seek_gm);
+    open_replay(&rp, e, &gm, &queue);
+    while (!rp.done && replay_now(&rp) < target) replay_tick(&rp);
+    if (sought != game_hash(&gm)) {
+      printf("rec %3zu  seek to tick %lu diverged from the replay\n", n,
+             (unsigned long)target);
+      failed = 1;
+    } else if (seek_tick != UINT32_MAX) {
+      printf("rec %3zu  tick %lu: len %u, %u fruits, hash %08lx\n", n,
+             (unsigned long)target, (unsigned)seek_gm.snake.len,
+             (unsigned)seek_gm.fruits.active_count,
+             (unsigned long)sought);
+    }
+  }
+  free(kf.frames);
+  return failed;
+}
+
+// Plays every recording rounds times, the standard engine workload
+static void bench(const RecFile *files, size_t nfiles, int rounds) {
+  static GameManager gm;
+  static Queue queue;
+  Replay rp;
+  uint64_t ticks = 0, games = 0;
+  uint64_t start = bench_ns();
+  for (int r = 0; r < rounds; ++r) {
+    for (size_t f = 0; f < nfiles; ++f) {
+      for (size_t i = 0; i < files[f].count; ++i) {
+        const RecEntry *e = &files[f].recs[i];
+        if (open_replay(&rp, e, &gm, &queue) != REPLAY_OK) {
+          continue;
+        }
+        replay_run(&rp);
+        ticks += replay_now(&rp);
+        games++;
+      }
+    }
+  }
+  double ns = (double)(bench_ns() - start);
+  printf("replay   %llu games, %llu ticks in %.3f s: %.1f ns/tick, %.0f ticks/s\n",
+         (unsigned long long)games, (unsigned long long)ticks, ns / 1e9,
+         ticks ? ns / ticks : 0.0, ns > 0 ? ticks * 1e9 / ns : 0.0);
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--seek TICK] [--keyframes N] [--bench ROUNDS] [--generic]\n"
+          "          FILE...\n"
+          "  --seek TICK     seek every recording to TICK and print the state\n"
+          "                  (default: check a seek to the middle of each)\n"
+          "  --keyframes N   ticks between keyframes (default %d)\n"
+          "  --bench ROUNDS  time ROUNDS replays of all recordings\n"
+          "  --generic       play on the generic tick kernel, not the one\n"
+          "                  specialised for the difficulty\n",
+          prog, KEYFRAME_TICKS);
+}
+
+int main(int argc, char **argv) {
+  uint32_t seek_tick = UINT32_MAX;
+  uint32_t every = KEYFRAME_TICKS;
+  int rounds = 0;
+  RecFile *files = calloc((size_t)argc, sizeof(*files));
+  size_t nfiles = 0;
+  if (files == NULL) return 1;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+      seek_tick = (uint32_t)strtoul(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--keyframes") == 0 && i + 1 < argc) {
+      every = (uint32_t)strtoul(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+      rounds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--generic") == 0) {
+      force_generic = true;
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+      return 1;
+    } else if (rec_file_load(argv[i], &files[nfiles]) != 0) {
+      fprintf(stderr, "%s: can not read recordings\n", argv[i]);
+      return 1;
+    } else {
+      nfiles++;
+    }
+  }
+  if (nfiles == 0 || every == 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  printf("board %dx%d, logic %d Hz, %s tick kernels\n", ROWS, COLS,
+         LOGIC_RATE_HZ, force_generic ? "generic" : "specialised");
+  size_t n = 0, failed = 0;
+  for (size_t f = 0; f < nfiles; ++f) {
+    for (size_t i = 0; i < files[f].count; ++i) {
+      failed += check_recording(n++, &files[f].recs[i], every, seek_tick);
+    }
+  }
+  printf("replayed %zu recordings, %zu failed\n", n, failed);
+  if (rounds > 0) bench(files, nfiles, rounds);
+  for (size_t f = 0; f < nfiles; ++f) rec_file_free(&files[f]);
+  free(files);
+  return failed || n == 0 ? 1 : 0;
+}
+
+/*****************************EOF replay_main.c*****************************/
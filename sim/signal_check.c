@@ -0,0 +1,74 @@
+/**
+ * @file signal_check.c
+ * @brief Ordering rules of the scan signals, checked on every pin edge:
+ * the latch only happens with BLANK high and all columns off, the column
+ * address only changes while columns are off, a column is only enabled with
+ * XLAT and BLANK low, and columns are enabled in scan order.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "signal_check.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "driver/gpio.h"
+#include "hal_sim.h"
+#include "pins.h"
+#include "tlc5947.h"
+
+#define MAX_REPORTED 10
+
+static SignalStats stats;
+static int last_col = -1;
+
+static void violation(const char *what) {
+  if (stats.violations++ < MAX_REPORTED) {
+    fprintf(stderr, "signal order violation #%llu: %s\n",
+            (unsigned long long)stats.violations, what);
+  }
+}
+
+static int selected_col(void) {
+  return gpio_get_level(HCT154_ADDR0) << 0 | gpio_get_level(HCT154_ADDR1) << 1 |
+         gpio_get_level(HCT154_ADDR2) << 2 | gpio_get_level(HCT154_ADDR3) << 3;
+}
+
+static void on_pin(int pin, int level) {
+  bool cols_off = gpio_get_level(HCT154_COL_EN) == 1;
+  switch (pin) {
+    case TLC_XLAT:
+      if (level == 1) {
+        stats.latches++;
+        if (gpio_get_level(TLC_BLANK) != 1) violation("XLAT rose with BLANK low");
+        if (!cols_off) violation("XLAT rose with a column enabled");
+      }
+      break;
+    case HCT154_ADDR0:
+    case HCT154_ADDR1:
+    case HCT154_ADDR2:
+    case HCT154_ADDR3:
+      if (!cols_off) violation("column address changed while enabled");
+      break;
+    case HCT154_COL_EN:
+      if (level == 0) {
+        stats.enables++;
+        if (gpio_get_level(TLC_XLAT) != 0) violation("column enabled during XLAT");
+        if (gpio_get_level(TLC_BLANK) != 0) violation("column enabled while blanked");
+        int col = selected_col();
+        if (last_col >= 0 && col != (last_col + 1) % COLS) {
+          violation("columns enabled out of scan order");
+        }
+        last_col = col;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+void signal_check_install(void) { hal_sim_set_pin_hook(on_pin); }
+
+const SignalStats *signal_check_stats(void) { return &stats; }
+
+/*****************************EOF signal_check.c*****************************/
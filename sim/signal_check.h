@@ -0,0 +1,22 @@
+/**
+ * @file signal_check.h
+ * @brief Checks the ordering of the scan signals (74HCT154 address/enable,
+ * TLC5947 XLAT/BLANK) on every simulated pin edge.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_SIGNAL_CHECK_H
+#define SIM_SIGNAL_CHECK_H
+
+#include <stdint.h>
+
+typedef struct {
+  uint64_t latches;     // XLAT rising edges
+  uint64_t enables;     // column enables (COL_EN falling edges)
+  uint64_t violations;  // broken ordering rules
+} SignalStats;
+
+void signal_check_install(void);
+const SignalStats *signal_check_stats(void);
+
+#endif
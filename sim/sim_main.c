@@ -0,0 +1,204 @@
+/**
+ * @file sim_main.c
+ * @brief Headless host simulator. Runs the unmodified firmware (app_main, the
+ * scan and game tasks) on a virtual clock and drives the buttons with a
+ * simple bot.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "bot.h"
+#include "esp_timer.h"
+#include "frame_buffers.h"
+#include "globals.h"
+#include "hal_sim.h"
+#include "latency.h"
+#include "models.h"
+#include "rec_file.h"
+#include "record.h"
+#include "scan_prof.h"
+#include "signal_check.h"
+
+#define BOT_PERIOD_US 50000  // the bot looks at the board once per game tick
+
+void app_main(void);
+extern GameManager gm;  // defined in main.c
+
+typedef struct {
+  unsigned long games;
+  unsigned long won;
+  unsigned long lost;
+  size_t max_len;
+  State last_state;
+} BotStats;
+
+static BotStats bot = {.last_state = GAME_IDLE};
+static Difficulty bot_difficulty = DIFF_EASY;  // the bot starts games of it
+static FILE *record_file;
+static unsigned long recorded;
+
+// Stores every game the firmware recorded, runs on the game task
+static void record_sink(const uint8_t *rec, size_t len) {
+  rec_file_write(record_file, rec, len);
+  recorded++;
+}
+
+static void press(Direction dir) { hal_sim_fire_isr_by_arg((void *)dir); }
+
+// Bot timer, runs on the virtual clock next to the firmware tasks
+static void bot_timer_cb(void *arg) {
+  (void)arg;
+  State state = gm.state;
+  if (state != bot.last_state && state != GAME_RUNNING &&
+      bot.last_state == GAME_RUNNING) {
+    bot.games++;
+    if (state == GAME_WON) bot.won++;
+    if (state == GAME_LOST) bot.lost++;
+  }
+  bot.last_state = state;
+
+  switch (state) {
+    case GAME_IDLE:
+      // step through the menu to the difficulty, then start
+      press(gm.difficulty.name == bot_difficulty ? DIR_UP : DIR_RIGHT);
+      break;
+    case GAME_WON:
+    case GAME_LOST:
+      press(DIR_UP);  // start / restart
+      break;
+    case GAME_RUNNING: {
+      if (gm.snake.len > bot.max_len) bot.max_len = gm.snake.len;
+      Direction dir = bot_choose(&gm);
+      if (dir != gm.snake.dir.name) press(dir);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static void print_frame(void) {
+  for (int r = 0; r < ROWS; ++r) {
+    for (int c = 0; c < COLS; ++c) {
+      putchar(fb_display[r][c] != BLACK_COLOR ? '#' : '.');
+    }
+    putchar('\n');
+  }
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--seconds N] [--seed N] [--frame] [--check-signals]\n"
+          "          [--difficulty N] [--record FILE]\n"
+          "  --seconds N  virtual time to simulate (default 60)\n"
+          "  --seed N     seed for the esp_random stand-in (default 1)\n"
+          "  --frame      print the last displayed frame\n"
+          "  --check-signals  verify the scan signal ordering on every edge\n"
+          "  --difficulty N  0 easy, 1 medium, 2 hard: games the bot plays\n"
+          "  --record FILE  append the recording of every game to FILE\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  double seconds = 60.0;
+  unsigned long seed = 1;
+  bool frame = false;
+  bool check_signals = false;
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = strtod(argv[++i], NULL);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--frame") == 0) {
+      frame = true;
+    } else if (strcmp(argv[i], "--check-signals") == 0) {
+      check_signals = true;
+    } else if (strcmp(argv[i], "--difficulty") == 0 && i + 1 < argc) {
+      bot_difficulty = (Difficulty)(strtoul(argv[++i], NULL, 0) % 3);
+    } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+      record_file = fopen(argv[++i], "a");
+      if (record_file == NULL) {
+        perror(argv[i]);
+        return 1;
+      }
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  hal_sim_seed((uint32_t)seed);
+  if (check_signals) signal_check_install();
+  if (record_file != NULL) record_set_sink(record_sink);
+  // console_poll must not block the virtual clock on an interactive terminal
+  fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+
+  esp_timer_handle_t bot_tmr;
+  const esp_timer_create_args_t bot_args = {.callback = &bot_timer_cb,
+                                            .name = "bot"};
+  ESP_ERROR_CHECK(esp_timer_create(&bot_args, &bot_tmr));
+  ESP_ERROR_CHECK(esp_timer_start_periodic(bot_tmr, BOT_PERIOD_US));
+
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  hal_sim_run(app_main, (int64_t)(seconds * 1e6));
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  double wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+  const hal_sim_stats_t *st = hal_sim_stats();
+  printf("simulated      %.1f s in %.3f s wall (%.0fx real time)\n", seconds,
+         wall, wall > 0 ? seconds / wall : 0.0);
+  printf("timer fires    %llu\n", (unsigned long long)st->timer_fires);
+  printf("spi transfers  %llu (%llu bytes)\n",
+         (unsigned long long)st->spi_transfers,
+         (unsigned long long)st->spi_bytes);
+  printf("gpio writes    %llu driver, %llu register\n",
+         (unsigned long long)st->gpio_writes,
+         (unsigned long long)st->reg_writes);
+  for (size_t i = 0; i < hal_sim_timer_count(); ++i) {
+    const char *name;
+    uint64_t calls, ns;
+    hal_sim_timer_info(i, &name, &calls, &ns);
+    printf("timer %-8s %llu calls, %.1f ns/call\n", name,
+           (unsigned long long)calls, calls ? (double)ns / calls : 0.0);
+  }
+  for (size_t i = 0; i < hal_sim_task_count(); ++i) {
+    const char *name;
+    uint64_t runs, ns;
+    hal_sim_task_info(i, &name, &runs, &ns);
+    printf("task  %-8s %llu runs, %.1f ns/run\n", name,
+           (unsigned long long)runs, runs ? (double)ns / runs : 0.0);
+  }
+  printf("games          %lu (won %lu, lost %lu), max len %zu\n", bot.games,
+         bot.won, bot.lost, bot.max_len);
+  printf("buttons        %lu pressed, %lu dropped\n",
+         (unsigned long)atomic_load(&button_events.head),
+         (unsigned long)button_events.dropped);
+  FbStats fbs;
+  fb_get_stats(&fbs);
+  printf("frames         %lu published, %lu shown, %lu dropped, %lu repeated\n",
+         (unsigned long)fbs.published, (unsigned long)fbs.shown,
+         (unsigned long)fbs.dropped, (unsigned long)fbs.repeated);
+  latency_print();
+  scan_prof_print();
+  if (record_file != NULL) {
+    printf("recorded       %lu games\n", recorded);
+    fclose(record_file);
+  }
+  if (frame) print_frame();
+  if (check_signals) {
+    const SignalStats *sig = signal_check_stats();
+    printf("signals        %llu latches, %llu column enables, %llu violations\n",
+           (unsigned long long)sig->latches, (unsigned long long)sig->enables,
+           (unsigned long long)sig->violations);
+    if (sig->violations) return 1;
+  }
+  return 0;
+}
+
+/*******************************EOF sim_main.c*******************************/
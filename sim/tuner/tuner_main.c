@@ -0,0 +1,397 @@
+/**
+ * @file tuner_main.c
+ * @brief Monte Carlo difficulty tuner. Plays bot games of every DIFFICULTIES
+ * entry (or of variants with changed fields) on the firmware engine across a
+ * work-stealing thread pool and reports win rate, game length and the engine
+ * throughput. Games are cut into chunks of CHUNK_GAMES, each with its own
+ * split random stream, so the results do not depend on the thread count or
+ * on which thread ran a chunk.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "bench_util.h"
+#include "bot.h"
+#include "difficulties.h"
+#include "dir_queue.h"
+#include "game.h"
+#include "models.h"
+#include "rng.h"
+#include "utils.h"
+#include "work_pool.h"
+
+#define CHUNK_GAMES 64     // games per task
+#define MAX_VARIANTS 64
+#define MAX_SETS 8
+#define HIST_SECONDS 1200  // game length histogram, 1 s buckets
+
+// Settable fields of Dif
+typedef struct {
+  const char *name;
+  size_t offset;
+  size_t size;
+} DifField;
+
+#define DIF_FIELD(f) {#f, offsetof(Dif, f), sizeof(((Dif *)0)->f)}
+static const DifField FIELDS[] = {
+    DIF_FIELD(move_ms),           DIF_FIELD(food_ms),
+    DIF_FIELD(evil_food_ms),      DIF_FIELD(food_spawn_chance),
+    DIF_FIELD(evil_food_spawn_chance),
+    DIF_FIELD(max_fruit),         DIF_FIELD(max_evil_fruit),
+    DIF_FIELD(fruit_ttl_ms),      DIF_FIELD(evil_fruit_ttl_ms),
+    DIF_FIELD(winning_len),       DIF_FIELD(min_snake_len),
+    DIF_FIELD(good_inc),          DIF_FIELD(evil_dec),
+};
+#define FIELD_COUNT (sizeof(FIELDS) / sizeof(FIELDS[0]))
+
+typedef struct {
+  const DifField *field;
+  unsigned long value;
+} FieldSet;
+
+typedef struct {
+  Dif dif;
+  char label[64];
+} Variant;
+
+typedef struct {
+  uint64_t games, won, lost, timeouts;
+  uint64_t ticks;      // logic ticks played
+  uint64_t final_len;  // sum of the snake length at the end
+  uint32_t hist[HIST_SECONDS + 1];  // game length in seconds, last = longer
+} VariantStats;
+
+typedef struct {
+  const Variant *variants;
+  size_t nvariants;
+  uint32_t chunks;      // per variant
+  uint64_t games;       // per variant
+  uint32_t max_ticks;   // games still running then count as timeouts
+  const Rng *streams;   // one per task
+  VariantStats *stats;  // [worker][variant]
+} Job;
+
+static void set_field(Dif *d, const DifField *f, unsigned long v) {
+  uint8_t *p = (uint8_t *)d + f->offset;
+  if (f->size == 1) *p = (uint8_t)v;
+  if (f->size == 2) *(uint16_t *)p = (uint16_t)v;
+  if (f->size == 4) *(uint32_t *)p = (uint32_t)v;
+}
+
+// Whether v fits the field without being cut off
+static bool field_fits(const DifField *f, unsigned long v) {
+  return f->size >= sizeof(v) || v >> (8 * f->size) == 0;
+}
+
+/**
+ * @brief Checks a variant against the limits of the engine, which would
+ * otherwise change the game without a word (a spawn with the fruit pool full
+ * is dropped, a period is rounded down to whole logic ticks).
+ * @return What is wrong with the variant, NULL if it can be played.
+ */
+static const char *dif_invalid(const Dif *d) {
+  if (d->max_fruit + d->max_evil_fruit > FRUIT_POOL_SIZE) {
+    return "max_fruit + max_evil_fruit exceeds the fruit pool";
+  }
+  const uint16_t periods[] = {d->move_ms, d->food_ms, d->evil_food_ms,
+                              d->fruit_ttl_ms, d->evil_fruit_ttl_ms};
+  for (size_t i = 0; i < sizeof(periods) / sizeof(periods[0]); ++i) {
+    if (DIF_PERIOD_BAD(periods[i])) {
+      return "a period is not a multiple of the logic tick";
+    }
+  }
+  return NULL;
+}
+
+static const DifField *find_field(const char *name, size_t len) {
+  for (size_t i = 0; i < FIELD_COUNT; ++i) {
+    if (strlen(FIELDS[i].name) == len &&
+        strncmp(FIELDS[i].name, name, len) == 0) {
+      return &FIELDS[i];
+    }
+  }
+  return NULL;
+}
+
+// Plays one bot game, the bot decides once per logic tick like in imp_sim
+static void play_game(const Dif *d, uint32_t seed, uint32_t max_ticks,
+                      VariantStats *st) {
+  GameManager gm;
+  Queue queue;
+  game_reset(&gm, d, seed);
+  queue_clear(&queue);
+  gm.state = GAME_RUNNING;
+  State res = GAME_RUNNING;
+  while (res == GAME_RUNNING && gm.sched.now < max_ticks) {
+    Direction dir = bot_choose(&gm);
+    if (dir != gm.snake.dir.name) insert_dir(&queue, dir, &gm);
+    res = game_tick(&gm, &queue);
+  }
+  st->games++;
+  st->won += res == GAME_WON;
+  st->lost += res == GAME_LOST;
+  st->timeouts += res == GAME_RUNNING;
+  st->ticks += gm.sched.now;
+  st->final_len += gm.snake.len;
+  uint32_t s = gm.sched.now / LOGIC_RATE_HZ;
+  st->hist[s < HIST_SECONDS ? s : HIST_SECONDS]++;
+}
+
+static void run_chunk(uint32_t task, int worker, void *ctx) {
+  const Job *job = ctx;
+  size_t v = task / job->chunks;
+  uint64_t first = (uint64_t)(task % job->chunks) * CHUNK_GAMES;
+  uint64_t n = job->games - first < CHUNK_GAMES ? job->games - first
+                                                : CHUNK_GAMES;
+  VariantStats *st = &job->stats[(size_t)worker * job->nvariants + v];
+  Rng rng = job->streams[task];
+  for (uint64_t i = 0; i < n; ++i) {
+    play_game(&job->variants[v].dif, rng_next(&rng), job->max_ticks, st);
+  }
+}
+
+// Adds the stats of every worker into the first one
+static void merge(VariantStats *stats, size_t nvariants, int threads) {
+  for (int w = 1; w < threads; ++w) {
+    for (size_t v = 0; v < nvariants; ++v) {
+      VariantStats *to = &stats[v], *from = &stats[(size_t)w * nvariants + v];
+      to->games += from->games;
+      to->won += from->won;
+      to->lost += from->lost;
+      to->timeouts += from->timeouts;
+      to->ticks += from->ticks;
+      to->final_len += from->final_len;
+      for (int s = 0; s <= HIST_SECONDS; ++s) to->hist[s] += from->hist[s];
+    }
+  }
+}
+
+static uint32_t percentile(const VariantStats *st, double p) {
+  uint64_t need = (uint64_t)(st->games * p + 0.5), seen = 0;
+  for (uint32_t s = 0; s <= HIST_SECONDS; ++s) {
+    seen += st->hist[s];
+    if (seen >= need && seen > 0) return s;
+  }
+  return HIST_SECONDS;
+}
+
+typedef struct {
+  double wall_s;
+  uint64_t ticks;
+  WorkPoolStats pool;
+  uint32_t digest;  // of the merged results, equal for any thread count
+} RunInfo;
+
+// Plays the whole workload on threads workers, stats gets the merged results
+static int run(Job *job, int threads, VariantStats **stats, RunInfo *info) {
+  size_t n = (size_t)threads * job->nvariants;
+  *stats = calloc(n, sizeof(VariantStats));
+  if (*stats == NULL) return 1;
+  job->stats = *stats;
+  uint64_t start = bench_ns();
+  if (work_pool_run((uint32_t)(job->chunks * job->nvariants), threads,
+                    run_chunk, job, &info->pool)) {
+    free(*stats);
+    return 1;
+  }
+  info->wall_s = (double)(bench_ns() - start) / 1e9;
+  merge(*stats, job->nvariants, threads);
+  info->ticks = 0;
+  info->digest = 2166136261u;
+  for (size_t v = 0; v < job->nvariants; ++v) {
+    const VariantStats *st = &(*stats)[v];
+    info->ticks += st->ticks;
+    const uint64_t fields[] = {st->won, st->lost, st->ticks, st->final_len};
+    for (size_t i = 0; i < 4; ++i) {
+      info->digest = (info->digest ^ (uint32_t)(fields[i] ^ fields[i] >> 32)) *
+                     16777619u;
+    }
+  }
+  return 0;
+}
+
+static void report(const Job *job, const VariantStats *stats,
+                   const RunInfo *info, int threads) {
+  printf("%-36s %9s %6s %6s %6s %8s %5s %5s %6s\n", "variant", "games",
+         "won%", "lost%", "tmo%", "mean s", "p50", "p90", "len");
+  for (size_t v = 0; v < job->nvariants; ++v) {
+    const VariantStats *st = &stats[v];
+    double g = st->games ? (double)st->games : 1.0;
+    printf("%-36s %9llu %6.2f %6.2f %6.2f %8.1f %5u %5u %6.1f\n",
+           job->variants[v].label, (unsigned long long)st->games,
+           100.0 * st->won / g, 100.0 * st->lost / g,
+           100.0 * st->timeouts / g, st->ticks / g / LOGIC_RATE_HZ,
+           percentile(st, 0.5), percentile(st, 0.9), st->final_len / g);
+  }
+  printf("ticks    %llu in %.3f s on %d threads: %.2f M ticks/s, %llu steals\n",
+         (unsigned long long)info->ticks, info->wall_s, threads,
+         info->wall_s > 0 ? info->ticks / info->wall_s / 1e6 : 0.0,
+         (unsigned long long)info->pool.steals);
+}
+
+// Thread counts of --scale: doubling up to max, max last
+static int next_threads(int t, int max) {
+  if (t >= max) return max + 1;
+  return t * 2 < max ? t * 2 : max;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [--games N] [--threads N] [--seed N] [--difficulty D]\n"
+          "          [--set FIELD=V]... [--sweep FIELD=FROM:TO:STEP]\n"
+          "          [--max-seconds N] [--scale]\n"
+          "  --games N        games per variant (default 100000)\n"
+          "  --threads N      worker threads (default: online cores)\n"
+          "  --seed N         master seed, the results only depend on it\n"
+          "  --difficulty D   0 easy, 1 medium, 2 hard (default all)\n"
+          "  --set FIELD=V    change a field of the difficulty\n"
+          "  --sweep FIELD=FROM:TO:STEP  one variant per value\n"
+          "  --max-seconds N  longer games count as timeouts (default 600)\n"
+          "  --scale          run on 1 .. N threads and report the speedup\n"
+          "fields:",
+          prog);
+  for (size_t i = 0; i < FIELD_COUNT; ++i) fprintf(stderr, " %s", FIELDS[i].name);
+  fputc('\n', stderr);
+}
+
+int main(int argc, char **argv) {
+  static const char *const diffs[3] = {"easy", "medium", "hard"};
+  unsigned long long games = 100000;
+  long threads = sysconf(_SC_NPROCESSORS_ONLN);
+  unsigned long long seed = 1;
+  int only = -1;
+  double max_seconds = 600;
+  bool scale = false;
+  FieldSet sets[MAX_SETS];
+  size_t nsets = 0;
+  const DifField *sweep = NULL;
+  unsigned long sweep_from = 0, sweep_to = 0, sweep_step = 1;
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(argv[i], "--games") == 0 && arg) {
+      games = strtoull(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--threads") == 0 && arg) {
+      threads = strtol(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--seed") == 0 && arg) {
+      seed = strtoull(argv[++i], NULL, 0);
+    } else if (strcmp(argv[i], "--difficulty") == 0 && arg) {
+      only = (int)(strtoul(argv[++i], NULL, 0) % 3);
+    } else if (strcmp(argv[i], "--max-seconds") == 0 && arg) {
+      max_seconds = strtod(argv[++i], NULL);
+    } else if (strcmp(argv[i], "--scale") == 0) {
+      scale = true;
+    } else if ((strcmp(argv[i], "--set") == 0 ||
+                strcmp(argv[i], "--sweep") == 0) && arg &&
+               strchr(arg, '=') != NULL) {
+      const char *eq = strchr(arg, '=');
+      const DifField *f = find_field(arg, (size_t)(eq - arg));
+      if (f == NULL) {
+        usage(argv[0]);
+        return 1;
+      }
+      if (strcmp(argv[i], "--set") == 0) {
+        if (nsets == MAX_SETS) return 1;
+        sets[nsets] = (FieldSet){f, strtoul(eq + 1, NULL, 0)};
+        if (!field_fits(f, sets[nsets++].value)) {
+          usage(argv[0]);
+          return 1;
+        }
+      } else if (sscanf(eq + 1, "%lu:%lu:%lu", &sweep_from, &sweep_to,
+                        &sweep_step) != 3 || sweep_step == 0 ||
+                 !field_fits(f, sweep_to)) {
+        usage(argv[0]);
+        return 1;
+      } else {
+        sweep = f;
+      }
+      ++i;
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (games == 0 || threads < 1 || threads > WORK_POOL_MAX_THREADS) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  // variants: the difficulties with the --set fields, times the sweep values
+  static Variant variants[MAX_VARIANTS];
+  size_t nvariants = 0;
+  for (int d = DIFF_EASY; d <= DIFF_HARD; ++d) {
+    if (only >= 0 && d != only) continue;
+    unsigned long v = sweep_from;
+    do {
+      if (nvariants == MAX_VARIANTS) break;
+      Variant *var = &variants[nvariants++];
+      var->dif = DIFFICULTIES[d];
+      int n = snprintf(var->label, sizeof(var->label), "%s", diffs[d]);
+      for (size_t s = 0; s < nsets; ++s) {
+        set_field(&var->dif, sets[s].field, sets[s].value);
+      }
+      if (sweep != NULL) {
+        set_field(&var->dif, sweep, v);
+        snprintf(var->label + n, sizeof(var->label) - (size_t)n, " %s=%lu",
+                 sweep->name, v);
+      }
+      v += sweep_step;
+    } while (sweep != NULL && v <= sweep_to);
+  }
+  for (size_t v = 0; v < nvariants; ++v) {
+    const char *why = dif_invalid(&variants[v].dif);
+    if (why != NULL) {
+      fprintf(stderr, "%s: %s\n", variants[v].label, why);
+      return 1;
+    }
+  }
+
+  Job job = {.variants = variants,
+             .nvariants = nvariants,
+             .chunks = (uint32_t)((games + CHUNK_GAMES - 1) / CHUNK_GAMES),
+             .games = games,
+             .max_ticks = (uint32_t)(max_seconds * LOGIC_RATE_HZ)};
+  // a split stream per task, fixed by the seed whatever runs the task
+  size_t tasks = (size_t)job.chunks * nvariants;
+  Rng *streams = malloc(tasks * sizeof(Rng));
+  if (streams == NULL) return 1;
+  Rng master;
+  rng_seed(&master, seed);
+  for (size_t t = 0; t < tasks; ++t) rng_split(&master, &streams[t]);
+  job.streams = streams;
+
+  printf("tuner    %zu variants x %llu games, board %dx%d, seed %llu\n",
+         nvariants, games, ROWS, COLS, seed);
+  for (size_t s = 0; s < nsets; ++s) {
+    printf("set      %s=%lu\n", sets[s].field->name, sets[s].value);
+  }
+  int failed = 0;
+  RunInfo base = {0};
+  for (int t = scale ? 1 : (int)threads; t <= threads;
+       t = next_threads(t, (int)threads)) {
+    VariantStats *stats;
+    RunInfo info;
+    if (run(&job, t, &stats, &info)) {
+      fprintf(stderr, "could not run on %d threads\n", t);
+      return 1;
+    }
+    if (!scale || t == threads) report(&job, stats, &info, t);
+    if (scale) {
+      if (t == 1) base = info;
+      bool same = info.digest == base.digest;
+      printf("scale    %3d threads %8.3f s  %7.2f M ticks/s  speedup %5.2f  %s\n",
+             t, info.wall_s, info.ticks / info.wall_s / 1e6,
+             base.wall_s / info.wall_s, same ? "same results" : "RESULTS DIFFER");
+      failed |= !same;
+    }
+    free(stats);
+  }
+  free(streams);
+  return failed;
+}
+
+/****************************EOF tuner_main.c*******************************/
@@ -0,0 +1,144 @@
+/**
+ * @file work_pool.c
+ * @brief Implementation of the work-stealing pool. A share is a range of task
+ * indices packed as begin << 32 | end. The owner advances begin and a thief
+ * lowers end, both with a compare-and-swap on the same word, so a task is
+ * handed out exactly once. A stolen range is private to the thief until it
+ * publishes the rest in its own (empty) share.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "work_pool.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+typedef struct {
+  _Alignas(64) _Atomic uint64_t range;  // own cache line, shares are hot
+  uint64_t tasks;
+  uint64_t steals;
+} Share;
+
+typedef struct {
+  Share *shares;
+  int threads;
+  WorkFn fn;
+  void *ctx;
+} Pool;
+
+typedef struct {
+  Pool *pool;
+  int id;
+} Worker;
+
+static inline uint64_t pack(uint32_t begin, uint32_t end) {
+  return (uint64_t)begin << 32 | end;
+}
+
+// Takes the first task of the own share
+static bool take_own(Share *own, uint32_t *task) {
+  uint64_t r = atomic_load_explicit(&own->range, memory_order_acquire);
+  for (;;) {
+    uint32_t begin = (uint32_t)(r >> 32), end = (uint32_t)r;
+    if (begin >= end) return false;
+    if (atomic_compare_exchange_weak_explicit(&own->range, &r,
+                                              pack(begin + 1, end),
+                                              memory_order_acq_rel,
+                                              memory_order_acquire)) {
+      *task = begin;
+      return true;
+    }
+  }
+}
+
+// Steals the back half of the largest share, runs its first task next and
+// publishes the rest as the own share
+static bool steal(Pool *pool, int id, uint32_t *task) {
+  for (;;) {
+    int victim = -1;
+    uint32_t most = 0;
+    uint64_t r = 0;
+    for (int i = 0; i < pool->threads; ++i) {
+      if (i == id) continue;
+      uint64_t v = atomic_load_explicit(&pool->shares[i].range,
+                                        memory_order_acquire);
+      uint32_t left = (uint32_t)v - (uint32_t)(v >> 32);
+      if ((uint32_t)(v >> 32) < (uint32_t)v && left > most) {
+        most = left;
+        victim = i;
+        r = v;
+      }
+    }
+    if (victim < 0) return false;  // nothing left anywhere
+    uint32_t begin = (uint32_t)(r >> 32), end = (uint32_t)r;
+    uint32_t split = end - (end - begin + 1) / 2;  // at least one task
+    if (!atomic_compare_exchange_strong_explicit(
+            &pool->shares[victim].range, &r, pack(begin, split),
+            memory_order_acq_rel, memory_order_acquire)) {
+      continue;  // the share moved on, look again
+    }
+    *task = split;
+    atomic_store_explicit(&pool->shares[id].range, pack(split + 1, end),
+                          memory_order_release);
+    pool->shares[id].steals++;
+    return true;
+  }
+}
+
+static void *worker_main(void *arg) {
+  Worker *w = arg;
+  Pool *pool = w->pool;
+  Share *own = &pool->shares[w->id];
+  uint32_t task;
+  while (take_own(own, &task) || steal(pool, w->id, &task)) {
+    pool->fn(task, w->id, pool->ctx);
+    own->tasks++;
+  }
+  return NULL;
+}
+
+/**
+ * @brief Runs tasks 0 .. tasks - 1 on threads workers, returns when all are
+ * done. The calling thread is worker 0.
+ * @param stats Totals of the run, may be NULL.
+ * @return 0 on success, 1 if the pool could not be set up.
+ */
+int work_pool_run(uint32_t tasks, int threads, WorkFn fn, void *ctx,
+                  WorkPoolStats *stats) {
+  if (fn == NULL || threads < 1 || threads > WORK_POOL_MAX_THREADS) return 1;
+  Share *shares = aligned_alloc(64, sizeof(Share) * (size_t)threads);
+  Worker *workers = calloc((size_t)threads, sizeof(Worker));
+  pthread_t *tids = calloc((size_t)threads, sizeof(pthread_t));
+  int err = shares == NULL || workers == NULL || tids == NULL;
+  Pool pool = {.shares = shares, .threads = threads, .fn = fn, .ctx = ctx};
+  for (int i = 0; !err && i < threads; ++i) {
+    uint32_t begin = (uint32_t)((uint64_t)tasks * i / threads);
+    uint32_t end = (uint32_t)((uint64_t)tasks * (i + 1) / threads);
+    atomic_init(&shares[i].range, pack(begin, end));
+    shares[i].tasks = shares[i].steals = 0;
+    workers[i] = (Worker){.pool = &pool, .id = i};
+  }
+  int started = 1;
+  for (; !err && started < threads; ++started) {
+    if (pthread_create(&tids[started], NULL, worker_main, &workers[started])) {
+      break;  // fewer workers, the others steal the share of the missing ones
+    }
+  }
+  if (!err) worker_main(&workers[0]);
+  for (int i = 1; i < started; ++i) pthread_join(tids[i], NULL);
+  if (stats != NULL && !err) {
+    *stats = (WorkPoolStats){0};
+    for (int i = 0; i < threads; ++i) {
+      stats->tasks += shares[i].tasks;
+      stats->steals += shares[i].steals;
+    }
+  }
+  free(shares);
+  free(workers);
+  free(tids);
+  return err;
+}
+
+/*****************************EOF work_pool.c*******************************/
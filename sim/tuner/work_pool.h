@@ -0,0 +1,29 @@
+/**
+ * @file work_pool.h
+ * @brief Work-stealing pool of host threads for a fixed set of tasks. Every
+ * worker starts with an even share of the task indices and takes them from
+ * the front. An idle worker steals the back half of the largest share left.
+ * The shares are single atomic words, so no worker ever takes a lock.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#ifndef SIM_WORK_POOL_H
+#define SIM_WORK_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WORK_POOL_MAX_THREADS 256
+
+// Runs one task, worker is the index of the thread (0 .. threads - 1)
+typedef void (*WorkFn)(uint32_t task, int worker, void *ctx);
+
+typedef struct {
+  uint64_t tasks;   // tasks run, over all workers
+  uint64_t steals;  // successful steals
+} WorkPoolStats;
+
+int work_pool_run(uint32_t tasks, int threads, WorkFn fn, void *ctx,
+                  WorkPoolStats *stats);
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file blit.c
+ * @brief Implementation of the 1-bpp blitter and the text renderer. A sprite
+ * row is clipped as one word and only its set bits are visited, so the cost
+ * follows the lit pixels, not the sprite area.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "blit.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "font.h"
+#include "models.h"
+
+// Draws the top w bits of bits at panel line y starting at column x
+static inline void blit_row(color_t (*fb)[COLS], uint32_t bits, int w, int x,
+                            int y, color_t color) {
+  if (y < 0 || y >= ROWS || x >= COLS || x + w <= 0) return;
+  if (x < 0) {  // clip left
+    bits <<= -x;
+    w += x;
+    x = 0;
+  }
+  if (x + w > COLS) w = COLS - x;  // clip right
+  if (w < 32) bits &= ~(UINT32_MAX >> w);  // drop the bits past the width
+  color_t *line = fb[ROWS - 1 - y];
+  while (bits) {
+    int lead = __builtin_clz(bits);
+    line[x + lead] = color;
+    bits &= ~(0x80000000u >> lead);
+  }
+}
+
+/**
+ * @brief Draws the set pixels of a sprite in one color, clipped to the panel.
+ * @param fb Framebuffer to draw into.
+ * @param sprite Sprite to draw.
+ * @param x Column of the left edge of the sprite, may be off the panel.
+ * @param y Line of the top edge of the sprite, may be off the panel.
+ * @param color Palette index of the set pixels, clear pixels stay untouched.
+ */
+void blit(color_t (*fb)[COLS], const Sprite *sprite, int x, int y,
+          color_t color) {
+  if (fb == NULL || sprite == NULL || sprite->w == 0 || sprite->w > 32) return;
+  int stride = (sprite->w + 7) / 8;
+  const uint8_t *row = sprite->rows;
+  for (int r = 0; r < sprite->h; ++r, row += stride) {
+    uint32_t bits = 0;
+    for (int b = 0; b < stride; ++b) bits |= (uint32_t)row[b] << (24 - 8 * b);
+    blit_row(fb, bits, sprite->w, x, y + r, color);
+  }
+}
+
+// Glyph of a character, lower case folds to upper case, NULL = blank
+static inline const uint8_t *glyph(char ch) {
+  if (ch >= 'a' && ch <= 'z') ch -= 'a' - 'A';
+  if (ch < FONT_FIRST || ch > FONT_LAST) return NULL;
+  return FONT_GLYPHS[ch - FONT_FIRST];
+}
+
+/**
+ * @brief Width of a text in pixels, without the spacing after the last glyph.
+ */
+int text_width(const char *text) {
+  if (text == NULL || *text == '\0') return 0;
+  int n = 0;
+  while (text[n]) n++;
+  return n * FONT_ADVANCE - 1;
+}
+
+/**
+ * @brief Draws a text in the 3x5 font, clipped to the panel.
+ * @param fb Framebuffer to draw into.
+ * @param text Zero terminated text.
+ * @param x Column of the left edge of the text.
+ * @param y Line of the top edge of the text.
+ * @param color Palette index of the text.
+ * @return Column right after the text (where the next glyph would go).
+ */
+int text_draw(color_t (*fb)[COLS], const char *text, int x, int y,
+              color_t color) {
+  if (fb == NULL || text == NULL) return x;
+  for (; *text; ++text, x += FONT_ADVANCE) {
+    const uint8_t *g = glyph(*text);
+    if (g == NULL || x >= COLS || x + FONT_W <= 0) continue;  // nothing to draw
+    for (int r = 0; r < FONT_H; ++r) {
+      blit_row(fb, (uint32_t)g[r] << 24, FONT_W, x, y + r, color);
+    }
+  }
+  return x;
+}
+
+/**
+ * @brief Starts a text scroll, the text enters from the right edge.
+ * @param ts Scroll state.
+ * @param text Zero terminated text, must stay valid while scrolling.
+ * @param y Line of the top edge of the text.
+ * @param color Palette index of the text.
+ * @param period Ticks per pixel of movement, at least 1.
+ */
+void text_scroll_start(TextScroll *ts, const char *text, int y, color_t color,
+                       uint8_t period) {
+  if (ts == NULL) return;
+  ts->text = text;
+  ts->width = text_width(text);
+  ts->y = y;
+  ts->color = color;
+  ts->period = period ? period : 1;
+  ts->wait = ts->period;
+  ts->step = 0;
+}
+
+/**
+ * @brief Advances a text scroll by one tick.
+ * @return true if the text moved and has to be redrawn.
+ */
+bool text_scroll_tick(TextScroll *ts) {
+  if (ts == NULL || text_scroll_done(ts)) return false;
+  if (--ts->wait > 0) return false;
+  ts->wait = ts->period;
+  ts->step++;
+  return ts->width > COLS;  // short text stays put
+}
+
+/**
+ * @brief Checks if the text made a whole pass (or was held as long).
+ */
+bool text_scroll_done(const TextScroll *ts) {
+  return ts == NULL || ts->step >= ts->width + COLS;
+}
+
+/**
+ * @brief Draws the text at its current scroll position.
+ */
+void text_scroll_draw(const TextScroll *ts, color_t (*fb)[COLS]) {
+  if (ts == NULL) return;
+  int x = ts->width > COLS ? COLS - ts->step : (COLS - ts->width) / 2;
+  text_draw(fb, ts->text, x, ts->y, ts->color);
+}
+
+/*********************************EOF blit.c**********************************/
@@ -0,0 +1,114 @@
+/**
+ * @file brightness.c
+ * @brief Implementation of the brightness and gamma lookup tables. The tables
+ * are only rebuilt when a setting changes, so the scan path does no floating
+ * point work. The settings change on the console task and the scan reads the
+ * table on the other core, so the tables are triple buffered like the frames
+ * (frame_buffers.c): each side owns one and swaps it with the parked one in a
+ * single atomic exchange.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "brightness.h"
+
+#include <math.h>
+#include <stdatomic.h>
+
+#include "esp_attr.h"
+
+#define LUT_COUNT 3
+#define LUT_INDEX_MASK 0x7F
+#define LUT_FRESH 0x80  // the parked table was not taken by the scan yet
+
+static uint16_t lut_buf[LUT_COUNT][BRIGHTNESS_LUT_SIZE];
+static uint8_t lut_back = 0;           // rebuilt, settings side only
+static uint8_t lut_front = 2;          // in use, scanner only
+static _Atomic uint8_t lut_ready = 1;  // parked table index | LUT_FRESH
+const uint16_t *brightness_lut = lut_buf[2];
+
+static uint16_t cur_level = BRIGHTNESS_MAX / 2;
+static uint16_t cur_gamma = GAMMA_LINEAR;
+
+/**
+ * @brief Rebuilds the own table from the current settings and parks it for
+ * the scan, the table parked before comes back to be rebuilt next time.
+ */
+static void rebuild(void) {
+  uint16_t *lut = lut_buf[lut_back];
+  for (uint32_t i = 0; i < BRIGHTNESS_LUT_SIZE; ++i) {
+    uint32_t x = i << 4;  // input value of the knot, 0..4096
+    uint32_t y;
+    if (cur_gamma == GAMMA_LINEAR) {
+      y = (x * cur_level) / BRIGHTNESS_MAX;  // exact for the linear case
+    } else {
+      float norm = powf((float)x / 4096.0f, cur_gamma / 100.0f);
+      y = (uint32_t)(norm * 4096.0f * cur_level / BRIGHTNESS_MAX);
+    }
+    lut[i] = y > 4095u ? 4095u : (uint16_t)y;
+  }
+  // release: the table is complete before the scan can take it
+  uint8_t prev = atomic_exchange_explicit(&lut_ready, lut_back | LUT_FRESH,
+                                          memory_order_acq_rel);
+  lut_back = prev & LUT_INDEX_MASK;
+}
+
+/**
+ * @brief Sets both settings and builds the first table. Call before the scan
+ * starts, brightness_acquire then takes the table.
+ * @param level Brightness 0..BRIGHTNESS_MAX.
+ * @param gamma_x100 Gamma in hundredths, GAMMA_LINEAR keeps values linear.
+ */
+void brightness_init(uint16_t level, uint16_t gamma_x100) {
+  lut_back = 0;
+  lut_front = 2;
+  brightness_lut = lut_buf[lut_front];
+  atomic_store(&lut_ready, 1);
+  cur_level = level > BRIGHTNESS_MAX ? BRIGHTNESS_MAX : level;
+  cur_gamma = gamma_x100 ? gamma_x100 : GAMMA_LINEAR;
+  rebuild();
+}
+
+/**
+ * @brief Changes the brightness, the table is rebuilt only on change.
+ * @param level Brightness 0..BRIGHTNESS_MAX, clamped.
+ */
+void brightness_set(uint16_t level) {
+  if (level > BRIGHTNESS_MAX) level = BRIGHTNESS_MAX;
+  if (level == cur_level) return;
+  cur_level = level;
+  rebuild();
+}
+
+uint16_t brightness_get(void) { return cur_level; }
+
+/**
+ * @brief Changes the gamma, the table is rebuilt only on change.
+ * @param gamma_x100 Gamma in hundredths, 0 falls back to GAMMA_LINEAR.
+ */
+void gamma_set(uint16_t gamma_x100) {
+  if (gamma_x100 == 0) gamma_x100 = GAMMA_LINEAR;
+  if (gamma_x100 == cur_gamma) return;
+  cur_gamma = gamma_x100;
+  rebuild();
+}
+
+uint16_t gamma_get(void) { return cur_gamma; }
+
+/**
+ * @brief Switches brightness_lut to the newest rebuilt table, if there is
+ * one. Only call from the scan, where no brightness_apply is in progress.
+ * @return true if the table changed, converted colors are stale then.
+ */
+bool IRAM_ATTR brightness_acquire(void) {
+  if (!(atomic_load_explicit(&lut_ready, memory_order_acquire) & LUT_FRESH)) {
+    return false;
+  }
+  // only the settings side writes lut_ready meanwhile and it keeps it fresh
+  uint8_t prev = atomic_exchange_explicit(&lut_ready, lut_front,
+                                          memory_order_acq_rel);
+  lut_front = prev & LUT_INDEX_MASK;
+  brightness_lut = lut_buf[lut_front];
+  return true;
+}
+
+/*******************************EOF brightness.c*******************************/
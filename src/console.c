@@ -0,0 +1,79 @@
+/**
+ * @file console.c
+ * @brief Single-key commands read from the serial console.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "console.h"
+
+#include <stdio.h>
+
+#include "brightness.h"
+#include "latency.h"
+#include "record.h"
+#include "scan_prof.h"
+
+#define BRIGHTNESS_STEP 16
+#define GAMMA_STEP 10
+
+static void print_help(void) {
+  printf("keys: + - brightness, g G gamma, l latency, p P scan profile/reset,\n"
+         "      r recording of the last game, ? help\n");
+}
+
+static void print_brightness(void) {
+  printf("brightness %u/%u, gamma %u.%02u\n", brightness_get(), BRIGHTNESS_MAX,
+         gamma_get() / 100, gamma_get() % 100);
+}
+
+/**
+ * @brief Handles all pending console input. Never blocks, meant to be called
+ * periodically from a task.
+ */
+void console_poll(void) {
+  int c;
+  while ((c = fgetc(stdin)) != EOF) {
+    switch (c) {
+      case '+':
+        brightness_set(brightness_get() + BRIGHTNESS_STEP);
+        print_brightness();
+        break;
+      case '-':
+        brightness_set(brightness_get() > BRIGHTNESS_STEP
+                           ? brightness_get() - BRIGHTNESS_STEP
+                           : 0);
+        print_brightness();
+        break;
+      case 'G':
+        gamma_set(gamma_get() + GAMMA_STEP);
+        print_brightness();
+        break;
+      case 'g':
+        gamma_set(gamma_get() > GAMMA_LINEAR ? gamma_get() - GAMMA_STEP
+                                             : GAMMA_LINEAR);
+        print_brightness();
+        break;
+      case 'l':
+        latency_print();
+        break;
+      case 'p':
+        scan_prof_print();
+        break;
+      case 'P':
+        scan_prof_reset();
+        printf("scan profile reset\n");
+        break;
+      case 'r':
+        record_print();
+        break;
+      case '?':
+        print_help();
+        break;
+      default:
+        break;
+    }
+  }
+  clearerr(stdin);  // no input is reported as EOF, keep the stream usable
+}
+
+/*******************************EOF console.c*******************************/
@@ -5,185 +5,200 @@
  * @date 18/12/2024 
  */
 #include "draw.h"
-#include "globals.h"
+#include "blit.h"
+#include "font.h"
+#include "frame_buffers.h"
+#include "fruit_pool.h"
+#include "game.h"
 #include "models.h"
+#include "screens.h"
+#include <stdio.h>
 #include <string.h>
 
+// Log of the cells the game changed, shared by all buffers, power of 2. A
+// buffer usually comes back to the renderer after FB_COUNT - 1 frames.
+#define DIRTY_LOG_SIZE 64
+#if DIRTY_LOG_SIZE < FB_COUNT * GM_DIRTY_MAX
+#error "DIRTY_LOG_SIZE must hold the changes of FB_COUNT frames"
+#endif
+
+static cell_t dirty_log[DIRTY_LOG_SIZE];
+static uint32_t dirty_head;            // cells logged so far
+static uint32_t fb_synced[FB_COUNT];   // dirty_head when last drawn into
+static bool fb_in_sync[FB_COUNT];      // false until drawn in full, then
+                                       // kept current by the dirty log
+
+// Prepared screens (screens.c) published by reference
+static uint8_t won_screen = FB_STATIC_NONE;
+static uint8_t lost_screen = FB_STATIC_NONE;
+static uint8_t idle_screens[3] = {FB_STATIC_NONE, FB_STATIC_NONE,
+                                  FB_STATIC_NONE};
+static uint8_t shown_screen = FB_STATIC_NONE;  // last one published
+
+// Won/lost: the screen for END_HOLD_TICKS, then the final length scrolls by
+#define END_HOLD_TICKS (2 * RENDER_RATE_HZ)  // 2 s in frames
+#define END_SCROLL_PERIOD (RENDER_RATE_HZ >= 20 ? RENDER_RATE_HZ / 10 : 1)  // frames per pixel
+static uint16_t end_ticks;    // frames since the end screen came up
+static TextScroll end_scroll;
+static char end_text[12];
+
 /**
- * @brief Replaces the current framebuffer with the baseline copy.  
- * WARNING: Depends on global fb0 and fb_draw.
+ * @brief Blanks the current draw buffer.
+ * WARNING: Depends on global fb_draw.
  */
 void fb_clear() {
-  // Clear the current draw buffer to the baseline.
-  memcpy(fb_draw, fb0, sizeof(fb_buf0));
+  // Palette index 0 is black.
+  memset(fb_draw, BLACK_COLOR, sizeof(color_t[ROWS][COLS]));
+  fb_in_sync[fb_draw_index()] = false;  // out of step with the dirty log
+}
+
+/**
+ * @brief Marks every framebuffer for a full redraw by draw_running, needed
+ * after anything else has drawn into them.
+ */
+void fb_invalidate() {
+  for (int i = 0; i < FB_COUNT; ++i) fb_in_sync[i] = false;
 }
 
 /**
- * @brief Requests a framebuffer swap at the next frame boundary.
- * WARNING: Depends on global fb_swap_pending.
+ * @brief Publishes the frame in fb_draw, the scanner switches to it at the
+ * next frame boundary. fb_draw moves on to another buffer.
+ * WARNING: Depends on global fb_draw.
  */
 void fb_swap() {
-  // Request to publish the frame --- the actual swap happens at frame boundary. 
-  fb_swap_pending = true;
+  fb_publish();
+  shown_screen = FB_STATIC_NONE;
 }
 
 // ==== DRAWING GAME STATES =====
 
+// Shows a prepared screen, publishes it only when it is not up already
+static void show_screen(uint8_t id) {
+  if (id == shown_screen) return;
+  fb_publish_static(id);
+  shown_screen = id;
+}
+
 /**
- * @brief Draws the wining screen to the framebuffer.
- * WARNING: Depends on global fb_draw and colors defined in models.h.
+ * @brief Registers the prepared screens with the framebuffers, call after
+ * fb_init.
  */
-void draw_won() {
+void draw_init() {
+  won_screen = fb_add_static(WON_SCREEN);
+  lost_screen = fb_add_static(LOST_SCREEN);
+  for (int i = 0; i < 3; ++i) idle_screens[i] = fb_add_static(IDLE_SCREENS[i]);
+  shown_screen = FB_STATIC_NONE;
+}
+
+// Holds the end screen, then scrolls the final length once, and again
+static void draw_end(GameManager *gm, uint8_t screen, color_t color) {
+  if (end_ticks < END_HOLD_TICKS) {
+    end_ticks++;
+    show_screen(screen);
+    return;
+  }
+  if (end_ticks == END_HOLD_TICKS) {
+    end_ticks++;
+    snprintf(end_text, sizeof(end_text), "LEN %u", (unsigned)gm->snake.len);
+    text_scroll_start(&end_scroll, end_text, (ROWS - FONT_H) / 2, color,
+                      END_SCROLL_PERIOD);
+  } else if (!text_scroll_tick(&end_scroll)) {
+    if (text_scroll_done(&end_scroll)) end_ticks = 0;  // back to the screen
+    return;  // the text did not move
+  }
   fb_clear();
-  // Draw W
-  fb_draw[ROWS - 1][2] = WON_COLOR;
-  fb_draw[ROWS - 2][2] = WON_COLOR;
-  fb_draw[ROWS - 1][13] = WON_COLOR;
-  fb_draw[ROWS - 2][13] = WON_COLOR;
-  fb_draw[ROWS - 3][3] = WON_COLOR;
-  fb_draw[ROWS - 4][3] = WON_COLOR;
-  fb_draw[ROWS - 3][7] = WON_COLOR;
-  fb_draw[ROWS - 4][7] = WON_COLOR;
-  fb_draw[ROWS - 3][8] = WON_COLOR;
-  fb_draw[ROWS - 4][8] = WON_COLOR;
-  fb_draw[ROWS - 3][12] = WON_COLOR;
-  fb_draw[ROWS - 4][12] = WON_COLOR;
-  fb_draw[ROWS - 5][4] = WON_COLOR;
-  fb_draw[ROWS - 6][4] = WON_COLOR;
-  fb_draw[ROWS - 5][6] = WON_COLOR;
-  fb_draw[ROWS - 6][6] = WON_COLOR;
-  fb_draw[ROWS - 5][9] = WON_COLOR;
-  fb_draw[ROWS - 6][9] = WON_COLOR;
-  fb_draw[ROWS - 5][11] = WON_COLOR;
-  fb_draw[ROWS - 6][11] = WON_COLOR;
-  fb_draw[ROWS - 7][5] = WON_COLOR;
-  fb_draw[ROWS - 8][5] = WON_COLOR;
-  fb_draw[ROWS - 7][10] = WON_COLOR;
-  fb_draw[ROWS - 8][10] = WON_COLOR;
+  text_scroll_draw(&end_scroll, fb_draw);
   fb_swap();
 }
 
 /**
- * @brief Draws the losing screen to the framebuffer.
- * WARNING: Depends on global fb_draw and colors defined in models.h.
+ * @brief Shows the wining screen, alternating with the final snake length.
+ * WARNING: Depends on the screens registered by draw_init.
  */
-void draw_lost() {
-  fb_clear();
-  // Letter L
-  fb_draw[ROWS - 1][5] = LOST_COLOR;
-  fb_draw[ROWS - 2][5] = LOST_COLOR;
-  fb_draw[ROWS - 3][5] = LOST_COLOR;
-  fb_draw[ROWS - 4][5] = LOST_COLOR;
-  fb_draw[ROWS - 5][5] = LOST_COLOR;
-  fb_draw[ROWS - 6][5] = LOST_COLOR;
-  fb_draw[ROWS - 7][5] = LOST_COLOR;
-  fb_draw[ROWS - 8][5] = LOST_COLOR;
-  fb_draw[ROWS - 1][6] = LOST_COLOR;
-  fb_draw[ROWS - 2][6] = LOST_COLOR;
-  fb_draw[ROWS - 3][6] = LOST_COLOR;
-  fb_draw[ROWS - 4][6] = LOST_COLOR;
-  fb_draw[ROWS - 5][6] = LOST_COLOR;
-  fb_draw[ROWS - 6][6] = LOST_COLOR;
-  fb_draw[ROWS - 7][6] = LOST_COLOR;
-  fb_draw[ROWS - 8][6] = LOST_COLOR;
-  fb_draw[ROWS - 8][7] = LOST_COLOR;
-  fb_draw[ROWS - 7][7] = LOST_COLOR;
-  fb_draw[ROWS - 8][8] = LOST_COLOR;
-  fb_draw[ROWS - 7][8] = LOST_COLOR;
-  fb_draw[ROWS - 8][9] = LOST_COLOR;
-  fb_draw[ROWS - 7][9] = LOST_COLOR;
-  fb_draw[ROWS - 8][10] = LOST_COLOR;
-  fb_draw[ROWS - 7][10] = LOST_COLOR;
-  fb_swap();
+void draw_won(GameManager *gm) {
+  if (gm == NULL) return;
+  draw_end(gm, won_screen, WON_COLOR);
 }
 
 /**
- * @brief Draws the idle screen to the framebuffer, including current difficulty.
- * WARNING: Depends on global fb_draw, colors defined in models.h
+ * @brief Shows the losing screen, alternating with the final snake length.
+ * WARNING: Depends on the screens registered by draw_init.
+ */
+void draw_lost(GameManager *gm) {
+  if (gm == NULL) return;
+  draw_end(gm, lost_screen, LOST_COLOR);
+}
+
+/**
+ * @brief Shows the idle screen of the currently selected difficulty.
+ * WARNING: Depends on the screens registered by draw_init.
  */
 void draw_idle(GameManager *gm) {
   if (gm == NULL) return;
-  fb_clear();
-  // H
-  int padding_top = 2;
-  int current = 1;
-  int current_dif = 3;
-  int space = 3;
-  fb_draw[ROWS - padding_top - 0][current] = TEXT_COLOR; // left vertical
-  fb_draw[ROWS - padding_top - 1][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 2][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 3][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 1][current + 1] = TEXT_COLOR; // middle horizontal
-  fb_draw[ROWS - padding_top - 2][current + 1] = TEXT_COLOR; 
-  fb_draw[ROWS - padding_top - 0][current + 2] = TEXT_COLOR; // right vertical
-  fb_draw[ROWS - padding_top - 1][current + 2] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 2][current + 2] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 3][current + 2] = TEXT_COLOR;
-  current += 2 + space;
-  // A
-  fb_draw[ROWS - padding_top - 1][current] = TEXT_COLOR; // left  vertical
-  fb_draw[ROWS - padding_top - 2][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 3][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 0][current + 1] = TEXT_COLOR;  // top horizontal
-  fb_draw[ROWS - padding_top - 0][current + 2] = TEXT_COLOR;  
-  fb_draw[ROWS - padding_top - 2][current + 1] = TEXT_COLOR;  // middle horizontal
-  fb_draw[ROWS - padding_top - 2][current + 2] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 1][current + 3] = TEXT_COLOR;  // right vertical
-  fb_draw[ROWS - padding_top - 2][current + 3] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 3][current + 3] = TEXT_COLOR;
-  current += 3 + space;
-  // D
-  fb_draw[ROWS - padding_top - 0][current] = TEXT_COLOR; // left vertical
-  fb_draw[ROWS - padding_top - 1][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 2][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 3][current] = TEXT_COLOR;
-  fb_draw[ROWS - padding_top - 0][current + 1] = TEXT_COLOR; // top horizontal
-  fb_draw[ROWS - padding_top - 3][current + 1] = TEXT_COLOR; // bottom horizontal
-  fb_draw[ROWS - padding_top - 1][current + 2] = TEXT_COLOR; // right vertical
-  fb_draw[ROWS - padding_top - 2][current + 2] = TEXT_COLOR;
-  // Difficulties
-  fb_draw[ROWS - 5 - padding_top][current_dif] = EASY_COLOR;
-  fb_draw[ROWS - 5 - padding_top][current_dif + 1] = EASY_COLOR;
-  if (gm->difficulty.name == DIFF_EASY) {
-    fb_draw[ROWS - 5 - padding_top][current_dif - 1] = SELECTED_COLOR;
-    fb_draw[ROWS - 5 - padding_top][current_dif + 2] = SELECTED_COLOR;
+  end_ticks = 0;
+  show_screen(idle_screens[gm->difficulty.name]);
+}
+
+// Color of a board cell in the running game
+static inline color_t cell_color(GameManager *gm, size_t cell) {
+  if (cell == cell_index(*snake_segment(&gm->snake, 0))) return SNAKE_HEAD_COLOR;
+  if (occ_test(gm->snake_occ, cell)) return SNAKE_COLOR;
+  uint8_t slot = gm->fruit_at[cell];
+  if (slot != 0) {
+    return gm->fruits.slots[slot - 1].is_evil ? EVIL_FRUIT_COLOR : FRUIT_COLOR;
   }
-  current_dif += space + 1;
-  fb_draw[ROWS - 5 - padding_top][current_dif] = MEDIUM_COLOR;
-  fb_draw[ROWS - 5 - padding_top][current_dif + 1] = MEDIUM_COLOR;
-  if (gm->difficulty.name == DIFF_MEDIUM) {
-    fb_draw[ROWS - 5 - padding_top][current_dif - 1] = SELECTED_COLOR;
-    fb_draw[ROWS - 5 - padding_top][current_dif + 2] = SELECTED_COLOR;
+  return BLACK_COLOR;
+}
+
+// Draws the whole running game into fb_draw
+static void draw_running_full(GameManager *gm) {
+  fb_clear();
+  // draw snake
+  for (size_t i = 0; i < gm->snake.len; i++) {
+    Pos *seg = snake_segment(&gm->snake, i);
+    fb_draw[seg->r][seg->c] = SNAKE_COLOR;
   }
-  current_dif += space + 1;
-  fb_draw[ROWS - 5 - padding_top][current_dif] = HARD_COLOR;
-  fb_draw[ROWS - 5 - padding_top][current_dif + 1] = HARD_COLOR;
-  if (gm->difficulty.name == DIFF_HARD) {
-    fb_draw[ROWS - 5 - padding_top][current_dif - 1] = SELECTED_COLOR;
-    fb_draw[ROWS - 5 - padding_top][current_dif + 2] = SELECTED_COLOR;
+  Pos *head = snake_segment(&gm->snake, 0);
+  fb_draw[head->r][head->c] = SNAKE_HEAD_COLOR;
+  // draw fruits
+  for (size_t i = 0; i < fruit_pool_count(&gm->fruits); i++) {
+    Fruit *fruit = fruit_pool_active(&gm->fruits, i);
+    color_t color = fruit->is_evil ? EVIL_FRUIT_COLOR 
+                                   :  FRUIT_COLOR;
+    fb_draw[fruit->pos.r][fruit->pos.c] = color;
   }
-  fb_swap();
 }
 
 /**
  * @brief Draws the running game state to the framebuffer, including snake and fruits.
+ * Only the cells changed since fb_draw was last drawn get redrawn, the game
+ * reports them in gm->dirty and they are logged for every buffer.
  * WARNING: Depends on global fb_draw and colors defined in models.h.
  */
 void draw_running(GameManager *gm) {
   if (gm == NULL) return;
-  fb_clear();
-  // draw snake
-  for (size_t i = 0; i < gm->snake.len; i++) {
-    fb_draw[gm->snake.body[i].r][gm->snake.body[i].c] = SNAKE_COLOR;
+  end_ticks = 0;
+  if (gm->dirty_full) {
+    fb_invalidate();
+  } else {
+    for (size_t i = 0; i < gm->dirty_count; i++) {
+      dirty_log[dirty_head++ & (DIRTY_LOG_SIZE - 1)] = gm->dirty[i];
+    }
   }
-  fb_draw[gm->snake.body[0].r][gm->snake.body[0].c] = SNAKE_HEAD_COLOR;
-  // draw fruits
-  for (size_t i = 0; i < MAX_GAME_ARRAY_LEN; i++) {
-    if (!gm->fruits[i].enabled) continue;
-    rgb16_t color = gm->fruits[i].is_evil ? EVIL_FRUIT_COLOR 
-                                         :  FRUIT_COLOR;
-    fb_draw[gm->fruits[i].pos.r][gm->fruits[i].pos.c] = color;
+  gm->dirty_count = 0;
+  gm->dirty_full = false;
+
+  int fb = fb_draw_index();
+  if (!fb_in_sync[fb] || dirty_head - fb_synced[fb] > DIRTY_LOG_SIZE) {
+    draw_running_full(gm);  // also when the log wrapped past this buffer
+  } else {
+    for (uint32_t i = fb_synced[fb]; i != dirty_head; i++) {
+      size_t cell = dirty_log[i & (DIRTY_LOG_SIZE - 1)];
+      fb_draw[cell / COLS][cell % COLS] = cell_color(gm, cell);
+    }
   }
+  fb_synced[fb] = dirty_head;
+  fb_in_sync[fb] = true;
   fb_swap();
 };
 
@@ -0,0 +1,67 @@
+/**
+ * @file event_ring.c
+ * @brief Implementation of the button event ring. The counters only grow and
+ * each one has a single writer, so push and pop are a load, a copy and a
+ * release store, with no lock and no waiting on either side.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "event_ring.h"
+
+#include "esp_attr.h"
+
+/**
+ * @brief Empties the ring, only while neither side is using it.
+ */
+void event_ring_clear(EventRing *ring) {
+  if (ring == NULL) return;
+  atomic_store(&ring->head, 0);
+  atomic_store(&ring->tail, 0);
+  ring->dropped = 0;
+}
+
+/**
+ * @brief Adds an event, producer side (the ISR).
+ * @return false if the ring is full, the event is dropped and counted.
+ */
+bool IRAM_ATTR event_ring_push(EventRing *ring, ButtonEvent ev) {
+  if (ring == NULL) return false;
+  uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+  if (head - tail >= EVENT_RING_SIZE) {
+    ring->dropped++;
+    return false;
+  }
+  ring->ev[head & (EVENT_RING_SIZE - 1)] = ev;
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Takes the oldest event, consumer side (the game task).
+ * @return false if the ring is empty.
+ */
+bool event_ring_pop(EventRing *ring, ButtonEvent *ev) {
+  if (ring == NULL || ev == NULL) return false;
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  if (tail == head) return false;
+  *ev = ring->ev[tail & (EVENT_RING_SIZE - 1)];
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+/**
+ * @brief Looks at the oldest event without taking it, consumer side.
+ * @return false if the ring is empty.
+ */
+bool event_ring_peek(EventRing *ring, ButtonEvent *ev) {
+  if (ring == NULL || ev == NULL) return false;
+  uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  if (tail == head) return false;
+  *ev = ring->ev[tail & (EVENT_RING_SIZE - 1)];
+  return true;
+}
+
+/******************************EOF event_ring.c******************************/
@@ -0,0 +1,65 @@
+/**
+ * @file font.c
+ * @brief 3x5 pixel font for the blitter, upper case letters, digits and a
+ * few symbols. Characters without a glyph are blank.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "font.h"
+
+#include <stdint.h>
+
+// A glyph row, three pixels left to right in the top bits of the byte
+#define R(bits) ((uint8_t)((bits) << 5))
+
+const uint8_t FONT_GLYPHS[FONT_LAST - FONT_FIRST + 1][FONT_H] = {
+    ['!' - FONT_FIRST] = {R(0b010), R(0b010), R(0b010), R(0b000), R(0b010)},
+    ['%' - FONT_FIRST] = {R(0b101), R(0b001), R(0b010), R(0b100), R(0b101)},
+    ['\'' - FONT_FIRST] = {R(0b010), R(0b010), R(0b000), R(0b000), R(0b000)},
+    ['(' - FONT_FIRST] = {R(0b001), R(0b010), R(0b010), R(0b010), R(0b001)},
+    [')' - FONT_FIRST] = {R(0b100), R(0b010), R(0b010), R(0b010), R(0b100)},
+    ['+' - FONT_FIRST] = {R(0b000), R(0b010), R(0b111), R(0b010), R(0b000)},
+    ['-' - FONT_FIRST] = {R(0b000), R(0b000), R(0b111), R(0b000), R(0b000)},
+    ['.' - FONT_FIRST] = {R(0b000), R(0b000), R(0b000), R(0b000), R(0b010)},
+    ['/' - FONT_FIRST] = {R(0b001), R(0b001), R(0b010), R(0b100), R(0b100)},
+    ['0' - FONT_FIRST] = {R(0b111), R(0b101), R(0b101), R(0b101), R(0b111)},
+    ['1' - FONT_FIRST] = {R(0b010), R(0b110), R(0b010), R(0b010), R(0b111)},
+    ['2' - FONT_FIRST] = {R(0b111), R(0b001), R(0b111), R(0b100), R(0b111)},
+    ['3' - FONT_FIRST] = {R(0b111), R(0b001), R(0b111), R(0b001), R(0b111)},
+    ['4' - FONT_FIRST] = {R(0b101), R(0b101), R(0b111), R(0b001), R(0b001)},
+    ['5' - FONT_FIRST] = {R(0b111), R(0b100), R(0b111), R(0b001), R(0b111)},
+    ['6' - FONT_FIRST] = {R(0b111), R(0b100), R(0b111), R(0b101), R(0b111)},
+    ['7' - FONT_FIRST] = {R(0b111), R(0b001), R(0b001), R(0b010), R(0b010)},
+    ['8' - FONT_FIRST] = {R(0b111), R(0b101), R(0b111), R(0b101), R(0b111)},
+    ['9' - FONT_FIRST] = {R(0b111), R(0b101), R(0b111), R(0b001), R(0b111)},
+    [':' - FONT_FIRST] = {R(0b000), R(0b010), R(0b000), R(0b010), R(0b000)},
+    ['=' - FONT_FIRST] = {R(0b000), R(0b111), R(0b000), R(0b111), R(0b000)},
+    ['?' - FONT_FIRST] = {R(0b110), R(0b001), R(0b010), R(0b000), R(0b010)},
+    ['A' - FONT_FIRST] = {R(0b010), R(0b101), R(0b111), R(0b101), R(0b101)},
+    ['B' - FONT_FIRST] = {R(0b110), R(0b101), R(0b110), R(0b101), R(0b110)},
+    ['C' - FONT_FIRST] = {R(0b011), R(0b100), R(0b100), R(0b100), R(0b011)},
+    ['D' - FONT_FIRST] = {R(0b110), R(0b101), R(0b101), R(0b101), R(0b110)},
+    ['E' - FONT_FIRST] = {R(0b111), R(0b100), R(0b110), R(0b100), R(0b111)},
+    ['F' - FONT_FIRST] = {R(0b111), R(0b100), R(0b110), R(0b100), R(0b100)},
+    ['G' - FONT_FIRST] = {R(0b011), R(0b100), R(0b101), R(0b101), R(0b011)},
+    ['H' - FONT_FIRST] = {R(0b101), R(0b101), R(0b111), R(0b101), R(0b101)},
+    ['I' - FONT_FIRST] = {R(0b111), R(0b010), R(0b010), R(0b010), R(0b111)},
+    ['J' - FONT_FIRST] = {R(0b001), R(0b001), R(0b001), R(0b101), R(0b010)},
+    ['K' - FONT_FIRST] = {R(0b101), R(0b101), R(0b110), R(0b101), R(0b101)},
+    ['L' - FONT_FIRST] = {R(0b100), R(0b100), R(0b100), R(0b100), R(0b111)},
+    ['M' - FONT_FIRST] = {R(0b101), R(0b111), R(0b111), R(0b101), R(0b101)},
+    ['N' - FONT_FIRST] = {R(0b110), R(0b101), R(0b101), R(0b101), R(0b101)},
+    ['O' - FONT_FIRST] = {R(0b010), R(0b101), R(0b101), R(0b101), R(0b010)},
+    ['P' - FONT_FIRST] = {R(0b110), R(0b101), R(0b110), R(0b100), R(0b100)},
+    ['Q' - FONT_FIRST] = {R(0b010), R(0b101), R(0b101), R(0b110), R(0b011)},
+    ['R' - FONT_FIRST] = {R(0b110), R(0b101), R(0b110), R(0b101), R(0b101)},
+    ['S' - FONT_FIRST] = {R(0b011), R(0b100), R(0b010), R(0b001), R(0b110)},
+    ['T' - FONT_FIRST] = {R(0b111), R(0b010), R(0b010), R(0b010), R(0b010)},
+    ['U' - FONT_FIRST] = {R(0b101), R(0b101), R(0b101), R(0b101), R(0b111)},
+    ['V' - FONT_FIRST] = {R(0b101), R(0b101), R(0b101), R(0b101), R(0b010)},
+    ['W' - FONT_FIRST] = {R(0b101), R(0b101), R(0b111), R(0b111), R(0b101)},
+    ['X' - FONT_FIRST] = {R(0b101), R(0b101), R(0b010), R(0b101), R(0b101)},
+    ['Y' - FONT_FIRST] = {R(0b101), R(0b101), R(0b010), R(0b010), R(0b010)},
+    ['Z' - FONT_FIRST] = {R(0b111), R(0b001), R(0b010), R(0b100), R(0b111)}};
+
+/*********************************EOF font.c**********************************/
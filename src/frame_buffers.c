@@ -0,0 +1,167 @@
+/**
+ * @file frame_buffers.c
+ * @brief Implementation of the triple buffer between the renderer and the
+ * scanner. Besides the buffer each side owns, the third one is parked in
+ * fb_ready and both sides only ever swap their own buffer with it in a single
+ * atomic exchange, so neither of them waits or sees a frame being drawn.
+ * Constant frames (screens) can be published by reference the same way, they
+ * just never come back to the renderer as a buffer to draw into.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "frame_buffers.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "models.h"
+
+#define FB_INDEX_MASK 0x7F
+#define FB_FRESH 0x80  // the parked frame was not shown yet
+#define FB_FRAMES (FB_COUNT + FB_STATIC_MAX)
+
+static color_t fb_bufs[FB_COUNT][ROWS][COLS];
+// Drawable buffers first, then the constant frames
+static const color_t (*fb_frames[FB_FRAMES])[COLS];
+static uint8_t fb_frame_count;
+color_t (*fb_draw)[COLS] = fb_bufs[0];
+const color_t (*fb_display)[COLS] = fb_bufs[2];
+
+// Buffers the renderer holds (1 or 2 of them), owned[0] is fb_draw
+static uint8_t owned[FB_COUNT] = {0};
+static uint8_t owned_count = 1;
+static uint8_t display_idx = 2;       // scanner only
+static _Atomic uint8_t fb_ready = 1;  // parked frame index | FB_FRESH
+// Sequence number of the frame held. A constant frame can be parked again
+// while the scanner reads its number, so the entries are atomic. The scanner
+// may then report the newer number, which names the same content.
+static _Atomic uint32_t fb_seq[FB_FRAMES];
+static _Atomic uint32_t shown_seq;
+static volatile FbStats stats;
+
+/**
+ * @brief Blanks all buffers, forgets the constant frames and resets the
+ * sequence numbers and counters. Call before the scanner and the renderer
+ * start.
+ */
+void fb_init(void) {
+  memset(fb_bufs, BLACK_COLOR, sizeof(fb_bufs));
+  for (int i = 0; i < FB_FRAMES; ++i) atomic_store(&fb_seq[i], 0);
+  for (int i = 0; i < FB_COUNT; ++i) fb_frames[i] = fb_bufs[i];
+  fb_frame_count = FB_COUNT;
+  owned[0] = 0;
+  owned_count = 1;
+  display_idx = 2;
+  fb_draw = fb_bufs[owned[0]];
+  fb_display = fb_frames[display_idx];
+  atomic_store(&fb_ready, 1);
+  atomic_store(&shown_seq, 0);
+  memset((void *)&stats, 0, sizeof(stats));
+}
+
+/**
+ * @brief Registers a constant frame that can be published by reference.
+ * @param frame The frame, must stay valid and unchanged.
+ * @return Id for fb_publish_static, FB_STATIC_NONE if the table is full.
+ */
+uint8_t fb_add_static(const color_t (*frame)[COLS]) {
+  if (frame == NULL || fb_frame_count >= FB_FRAMES) return FB_STATIC_NONE;
+  fb_frames[fb_frame_count] = frame;
+  return fb_frame_count++;
+}
+
+// Parks a frame for the scanner, a drawable buffer that comes back goes to
+// the renderer
+static uint32_t park(uint8_t idx) {
+  uint32_t seq = ++stats.published;
+  // the exchange below releases it to the scanner
+  atomic_store_explicit(&fb_seq[idx], seq, memory_order_relaxed);
+  uint8_t prev = atomic_exchange_explicit(&fb_ready, idx | FB_FRESH,
+                                          memory_order_acq_rel);
+  if (prev & FB_FRESH) stats.dropped++;
+  prev &= FB_INDEX_MASK;
+  if (prev < FB_COUNT) owned[owned_count++] = prev;
+  return seq;
+}
+
+/**
+ * @brief Hands the finished fb_draw to the scanner and continues with another
+ * buffer. Never blocks, a parked frame that was not shown yet is dropped in
+ * favor of the new one.
+ * @return Sequence number of the published frame.
+ * @note fb_draw holds an older frame afterwards, not the published one.
+ */
+uint32_t fb_publish(void) {
+  // the scanner and fb_ready hold at most two buffers, one stays here
+  uint8_t idx = owned[0];
+  owned[0] = owned[--owned_count];
+  uint32_t seq = park(idx);
+  fb_draw = fb_bufs[owned[0]];
+  return seq;
+}
+
+/**
+ * @brief Publishes a constant frame by reference, fb_draw stays as it is.
+ * @param id Id from fb_add_static.
+ * @return Sequence number of the published frame, 0 for an unknown id.
+ */
+uint32_t fb_publish_static(uint8_t id) {
+  if (id < FB_COUNT || id >= fb_frame_count) return 0;
+  return park(id);
+}
+
+/**
+ * @brief Switches fb_display to the newest published frame, if there is one.
+ * Only call at the frame boundary of the scan.
+ * @return true if fb_display changed.
+ */
+bool IRAM_ATTR fb_acquire(void) {
+  if (!(atomic_load_explicit(&fb_ready, memory_order_acquire) & FB_FRESH)) {
+    stats.repeated++;
+    return false;
+  }
+  // only the renderer writes fb_ready meanwhile and it keeps it fresh
+  uint8_t prev = atomic_exchange_explicit(&fb_ready, display_idx,
+                                          memory_order_acq_rel);
+  display_idx = prev & FB_INDEX_MASK;
+  fb_display = fb_frames[display_idx];
+  uint32_t seq = atomic_load_explicit(&fb_seq[display_idx],
+                                      memory_order_relaxed);
+  atomic_store_explicit(&shown_seq, seq, memory_order_release);
+  stats.shown++;
+  return true;
+}
+
+/**
+ * @brief Index of fb_draw among the FB_COUNT buffers, for per-buffer
+ * bookkeeping of the renderer.
+ */
+int fb_draw_index(void) { return owned[0]; }
+
+/**
+ * @brief Sequence number of the frame on the display. Once this reaches the
+ * number fb_publish returned, that frame was shown or superseded.
+ */
+uint32_t fb_shown_seq(void) {
+  return atomic_load_explicit(&shown_seq, memory_order_acquire);
+}
+
+/**
+ * @brief Sequence number of the last published frame, renderer side.
+ */
+uint32_t fb_published_seq(void) { return stats.published; }
+
+/**
+ * @brief Copies the frame counters.
+ * @param out Output, untouched if NULL.
+ */
+void fb_get_stats(FbStats *out) {
+  if (out == NULL) return;
+  out->published = stats.published;
+  out->shown = stats.shown;
+  out->dropped = stats.dropped;
+  out->repeated = stats.repeated;
+}
+
+/***************************EOF frame_buffers.c*******************************/
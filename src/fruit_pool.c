@@ -0,0 +1,59 @@
+/**
+ * @file fruit_pool.c
+ * @brief Implementation of the fixed pool of fruits. Live fruits are kept in
+ * a dense list so iterating them never touches unused slots, unused slots
+ * are kept on a free stack. Slot numbers stay stable while a fruit lives.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "fruit_pool.h"
+
+#include "models.h"
+
+/**
+ * @brief Empties the pool, all slots become free.
+ * @param pool Pointer to the FruitPool structure.
+ */
+void fruit_pool_init(FruitPool *pool) {
+  if (pool == NULL) return;
+  pool->active_count = 0;
+  pool->free_count = FRUIT_POOL_SIZE;
+  for (uint8_t i = 0; i < FRUIT_POOL_SIZE; ++i) {
+    // lowest slot on top of the stack, so slots are handed out in order
+    pool->free[i] = FRUIT_POOL_SIZE - 1 - i;
+  }
+}
+
+/**
+ * @brief Takes a free slot and appends it to the live list.
+ * @param pool Pointer to the FruitPool structure.
+ * @param slot Pointer to store the slot number, the caller fills the fruit.
+ * @return false if the pool is full (slot is left untouched).
+ */
+bool fruit_pool_alloc(FruitPool *pool, uint8_t *slot) {
+  if (pool == NULL || slot == NULL || pool->free_count == 0) return false;
+  uint8_t s = pool->free[--pool->free_count];
+  pool->active_pos[s] = pool->active_count;
+  pool->active[pool->active_count++] = s;
+  *slot = s;
+  return true;
+}
+
+/**
+ * @brief Returns a live slot to the free stack. The last live fruit takes its
+ * place in the live list, so the list stays dense.
+ * @param pool Pointer to the FruitPool structure.
+ * @param slot Slot previously returned by fruit_pool_alloc.
+ * @note Live fruits after the released one may change their list position,
+ * iterate backwards when releasing while iterating.
+ */
+void fruit_pool_release(FruitPool *pool, uint8_t slot) {
+  if (pool == NULL || slot >= FRUIT_POOL_SIZE) return;
+  uint8_t pos = pool->active_pos[slot];
+  uint8_t last = pool->active[--pool->active_count];
+  pool->active[pos] = last;
+  pool->active_pos[last] = pos;
+  pool->free[pool->free_count++] = slot;
+}
+
+/******************************EOF fruit_pool.c******************************/
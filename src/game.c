@@ -6,13 +6,55 @@
  */
 #include "game.h"
 
+#include <assert.h>
 #include <stdbool.h>
+#include <string.h>
 
+#include "difficulties.h"
 #include "dir_queue.h"
+#include "fruit_pool.h"
 #include "models.h"
+#include "scheduler.h"
 #include "tlc5947.h"  // for rows and cols
 #include "utils.h"
 
+// Bodies shared by the public functions and the tick kernels, a kernel gets
+// them all inlined with its difficulty as constants
+#define KERNEL_INLINE static inline __attribute__((always_inline))
+// 1 = every game_tick checks that a specialised kernel still fits
+// gm->difficulty. The check reads the settings the kernels leave out, so it
+// is off unless debugging (the sim turns it on in Debug builds).
+#ifndef TICK_KERNEL_CHECK
+#define TICK_KERNEL_CHECK 0
+#endif
+
+// A period in logic ticks, at least one, exact for the table (difficulties.h)
+static inline uint32_t logic_ticks(uint16_t ms) {
+  uint32_t ticks = ms / LOGIC_TICK_MS;
+  return ticks ? ticks : 1;
+}
+
+// Puts fruit slot i on the cell, keeps the fruit index and bitmap in step
+static inline void fruit_cell_set(GameManager *gm, size_t cell, size_t i) {
+  gm->fruit_at[cell] = (uint8_t)(i + 1);
+  occ_set(gm->fruit_occ, cell);
+}
+
+static inline void fruit_cell_clear(GameManager *gm, size_t cell) {
+  gm->fruit_at[cell] = 0;
+  occ_clear(gm->fruit_occ, cell);
+}
+
+// Records a cell whose color changed for the renderer, draw_running takes
+// the list
+static inline void mark_dirty(GameManager *gm, size_t cell) {
+  if (gm->dirty_count < GM_DIRTY_MAX) {
+    gm->dirty[gm->dirty_count++] = (cell_t)cell;
+  } else {
+    gm->dirty_full = true;
+  }
+}
+
 /**
  * @brief Checks if two positions collide (are the same).
  *
@@ -29,18 +71,14 @@ bool is_collision(Pos *a, Pos *b) {
  * @brief Checks if the snake collides with itself.
  * @param gm Pointer to the GameManager structure.
  * @return true if collision is detected, false otherwise.
+ * @note The test itself happens in move_snake against the occupancy bitmap,
+ * when the new head lands on a cell that is still taken.
  */
 bool collision_detected(GameManager *gm) {
   if (gm == NULL) {
     return false;
   }
-  Pos head = gm->snake.body[0];
-  for (size_t i = 1; i < gm->snake.len; i++) {
-    if (is_collision(&head, &gm->snake.body[i])) {
-      return true;
-    }
-  }
-  return false;
+  return gm->self_hit;
 }
 
 /**
@@ -55,156 +93,97 @@ bool food_eaten(GameManager *gm, bool *is_evil) {
   if (gm == NULL) {
     return false;
   }
-  Pos head = gm->snake.body[0];
-  for (size_t i = 0; i < MAX_GAME_ARRAY_LEN; i++) {  // check all fruits
-    if (!gm->fruits[i].enabled) continue;           // only check enabled fruits
-    if (is_collision(&head, &gm->fruits[i].pos)) {  // collision with fruit
-      if (is_evil) {
-        *is_evil = gm->fruits[i].is_evil;
-      }
-
-      // Remove fruit from array
-      gm->fruits[i].enabled = false;
-      if (gm->fruits[i].is_evil) {
-        gm->evil_fruit_count--;
-      } else {
-        gm->fruit_count--;
-      }
-
-      return true;
-    }  // collision with fruit
-  }    // all fruits
-  return false;
-}
-
-/**
- * @brief Finds a free index in the fruits array of the GameManager.
- * @param gm Pointer to the GameManager structure.
- * @return Index of a free slot in the fruits array. If no free slot is found,
- * returns MIN_GAME_ARRAY_LEN even if it is occupied.
- */
-size_t get_free_index(GameManager *gm) {
-  if (gm == NULL) {
-    return MIN_GAME_ARRAY_LEN;
+  size_t cell = cell_index(*snake_segment(&gm->snake, 0));
+  uint8_t slot = gm->fruit_at[cell];
+  if (slot == 0) {  // no fruit under the head
+    return false;
   }
-  size_t i = 0;  // if the array is full the last index will be returned (this
-                 // will never happen so whatever)
-  for (; i < MAX_GAME_ARRAY_LEN; ++i) {
-    if (!gm->fruits[i].enabled) {
-      return i;
-    }
+  Fruit *fruit = &gm->fruits.slots[slot - 1];
+  if (is_evil) {
+    *is_evil = fruit->is_evil;
   }
-  return MIN_GAME_ARRAY_LEN;
-}
 
-/**
- * @brief Removes expired fruits from the game.
- * @param gm Pointer to the GameManager structure.
- */
-void remove_expired_fruits(GameManager *gm) {
-  if (gm == NULL) {
-    return;
-  }
-  for (size_t i = 0; i < MAX_GAME_ARRAY_LEN; ++i) {
-    if (!gm->fruits[i].enabled) continue;  // only modify enabled fruits
-
-    gm->fruits[i].ttl--;            // decrease ttl
-    if (gm->fruits[i].ttl <= 0) {   // fruit expired
-      if (gm->fruits[i].is_evil) {  // decrease the correct counter
-        gm->evil_fruit_count--;
-      } else {
-        gm->fruit_count--;
-      }
-      gm->fruits[i].enabled = false;  // disable the fruit
-    }
+  // Remove fruit from the pool
+  if (fruit->is_evil) {
+    gm->evil_fruit_count--;
+  } else {
+    gm->fruit_count--;
   }
+  fruit_cell_clear(gm, cell);
+  fruit_pool_release(&gm->fruits, slot - 1);
+  sched_cancel(&gm->sched, EV_EXPIRE + slot - 1);  // eaten before it expired
+  return true;
 }
 
 /**
- * @brief Determines whether a new fruit should be spawned based on the game
- * state.
+ * @brief Removes a fruit whose time to live ran out.
  * @param gm Pointer to the GameManager structure.
- * @return true if a new fruit should be spawned, false otherwise.
+ * @param slot Pool slot of the fruit.
  */
-bool should_spawn_fruit(GameManager *gm) {
-  if (gm == NULL) {
-    return false;
+void expire_fruit(GameManager *gm, uint8_t slot) {
+  if (gm == NULL || slot >= FRUIT_POOL_SIZE) {
+    return;
   }
-  static int frame_counter = 0;  // the fruit has a period in game ticks
-  frame_counter++;
-  if (frame_counter >= gm->difficulty.food_T) {
-    frame_counter = 0;
-    if (gm->fruit_count < gm->difficulty.max_fruit) {
-      return true;
-    }
+  Fruit *fruit = &gm->fruits.slots[slot];
+  if (fruit->is_evil) {  // decrease the correct counter
+    gm->evil_fruit_count--;
+  } else {
+    gm->fruit_count--;
   }
-  return false;
+  fruit_cell_clear(gm, cell_index(fruit->pos));
+  mark_dirty(gm, cell_index(fruit->pos));
+  fruit_pool_release(&gm->fruits, slot);
 }
 
-/**
- * @brief Determines whether a new evil fruit should be spawned based on the
- * game state.
- * @param gm Pointer to the GameManager structure.
- * @return true if a new evil fruit should be spawned, false otherwise.
- */
-bool should_spawn_evil_fruit(GameManager *gm) {
-  if (gm == NULL) {
-    return false;
+// Free cells of bitmap word w, the bits past the last cell are never free
+static inline uint32_t free_word(const GameManager *gm, size_t w) {
+  uint32_t free = ~(gm->snake_occ[w] | gm->fruit_occ[w]);
+  if (w == OCC_WORDS - 1 && BOARD_CELLS % 32) {
+    free &= (1u << (BOARD_CELLS % 32)) - 1;
   }
-  static int evil_frame_counter = 0;
-  evil_frame_counter++;
-  if (evil_frame_counter >= gm->difficulty.evil_food_T) {
-    evil_frame_counter = 0;
-    if (gm->evil_fruit_count < gm->difficulty.max_evil_fruit) {
-      return true;
-    }
-  }
-  return false;
+  return free;
 }
 
 /**
- * @brief Generates a random valid position for a new fruit.
+ * @brief Picks a position for a new fruit uniformly among all free cells.
+ * Counts the free cells of the snake and fruit bitmaps, draws a rank and
+ * selects the cell with that rank, so the cost is bounded by the board size
+ * and a free cell is always found if one exists.
  * @param gm Pointer to the GameManager structure.
  * @param _valid Pointer to a boolean that will be set to true if a valid
- * position was found, false otherwise.
- * @return A valid position for a new fruit. If no valid position is found,
- * returns (0,0) and sets _valid to false. If gm or _valid is NULL, returns
- * (0,0) and invariant towards _valid.
+ * position was found, false if the board is full.
+ * @return A free position for a new fruit. If the board is full, returns (0,0)
+ * and sets _valid to false. If gm or _valid is NULL, returns (0,0) and
+ * invariant towards _valid.
  */
 Pos get_pos(GameManager *gm, bool *_valid) {
   if (gm == NULL || _valid == NULL) {
     return (Pos){0, 0};  // invariant towards _valid
   }
-  bool found = false;
-  int max_attempts = 1000;
-  Pos new_pos = {};
-
-  while (!found && max_attempts--) {
-    new_pos.r = rand_range(0, ROWS - 1);
-    new_pos.c = rand_range(0, COLS - 1);
-    found = true;
+  size_t free_cells = 0;
+  for (size_t w = 0; w < OCC_WORDS; ++w) {
+    free_cells += (size_t)__builtin_popcount(free_word(gm, w));
+  }
+  if (free_cells == 0) {  // board full
+    *_valid = false;
+    return (Pos){0, 0};
+  }
 
-    // snake collision
-    for (size_t i = 0; i < gm->snake.len; ++i) {
-      if (is_collision(&new_pos, &gm->snake.body[i])) {
-        found = false;
-        break;
-      }
-    }
-
-    if (!found) continue;
-
-    // fruit collision
-    for (size_t i = 0; i < MAX_GAME_ARRAY_LEN; ++i) {
-      if (!gm->fruits[i].enabled) continue;
-      if (is_collision(&new_pos, &gm->fruits[i].pos)) {
-        found = false;
-        break;
-      }
+  size_t rank = (size_t)rand_range(&gm->rng, 0, (int)free_cells - 1);
+  for (size_t w = 0; w < OCC_WORDS; ++w) {
+    uint32_t free = free_word(gm, w);
+    size_t count = (size_t)__builtin_popcount(free);
+    if (rank >= count) {
+      rank -= count;
+      continue;
     }
+    while (rank--) free &= free - 1;  // drop the lower free cells
+    size_t cell = w * 32 + (size_t)__builtin_ctz(free);
+    *_valid = true;
+    return (Pos){(int)(cell / COLS), (int)(cell % COLS)};
   }
-  *_valid = found;
-  return new_pos;
+  *_valid = false;  // unreachable, the ranks add up to free_cells
+  return (Pos){0, 0};
 }
 
 /**
@@ -243,21 +222,12 @@ Difficulty get_prev_difficulty(Difficulty current) {
   return current;
 }
 
-/**
- * @brief Checks the game conditions to determine if the game is won, lost,
- * or still running.
- * @param gm Pointer to the GameManager structure.
- * @return Returns the appropriate game state change based on current
- * conditions. (GAME_RUNNING, GAME_WON, GAME_LOST)
- */
-State check_conditions(GameManager *gm) {
-  if (gm == NULL) {
-    return GAME_RUNNING;
-  }  // keep the presumably current state
-  if (gm->snake.len < gm->difficulty.min_snake_len) {
+// Body of check_conditions for the settings d
+KERNEL_INLINE State check_conditions_k(GameManager *gm, const Dif *d) {
+  if (gm->snake.len < d->min_snake_len) {
     return GAME_LOST;
   }
-  if (gm->snake.len > gm->difficulty.winning_len) {
+  if (gm->snake.len > d->winning_len) {
     return GAME_WON;
   }
   if (collision_detected(gm)) {
@@ -266,67 +236,76 @@ State check_conditions(GameManager *gm) {
   bool evil = false;
   if ((food_eaten(gm, &evil))) {
     if (evil) {
-      gm->buffered_len -= gm->difficulty.evil_dec;
+      gm->buffered_len -= d->evil_dec;
     } else {
-      gm->buffered_len += gm->difficulty.good_inc;
+      gm->buffered_len += d->good_inc;
     }
   }
   return GAME_RUNNING;
 }
 
 /**
- * @brief Spawns new fruits in the game based on the current game state.
+ * @brief Checks the game conditions to determine if the game is won, lost,
+ * or still running.
  * @param gm Pointer to the GameManager structure.
+ * @return Returns the appropriate game state change based on current
+ * conditions. (GAME_RUNNING, GAME_WON, GAME_LOST)
  */
-void spawn_fruit(GameManager *gm) {
+State check_conditions(GameManager *gm) {
   if (gm == NULL) {
-    return;
+    return GAME_RUNNING;
+  }  // keep the presumably current state
+  return check_conditions_k(gm, &gm->difficulty);
+}
+
+// Body of spawn_fruit for the settings d
+KERNEL_INLINE void spawn_fruit_k(GameManager *gm, bool is_evil, const Dif *d) {
+  uint8_t *count = is_evil ? &gm->evil_fruit_count : &gm->fruit_count;
+  if (*count >= (is_evil ? d->max_evil_fruit : d->max_fruit)) {
+    return;  // field is full of this kind, no roll
   }
-  // spawn fruit
-  if (should_spawn_fruit(gm) &&
-      rand_range(0, 100) <
-          gm->difficulty
-              .food_spawn_chance) {  // its time to spawn fruit, roll for chance
-    bool valid = false;
-    Pos new_pos = get_pos(gm, &valid);  // get position
-    if (valid) {                        // there may not be space for new fruit
-      size_t free_index = get_free_index(gm);  // free index in the fruits array
-      gm->fruits[free_index] = (Fruit){.pos = new_pos,  // spawn fruit
-                                       .is_evil = false,
-                                       .ttl = gm->difficulty.fruit_ttl,
-                                       .enabled = true};
-      gm->fruit_count++;
-    }
+  // rand_range(0, 100), inline so a kernel folds the chance compare
+  if ((int)rng_below(&gm->rng, 101) >=
+      (is_evil ? d->evil_food_spawn_chance : d->food_spawn_chance)) {
+    return;  // roll for chance
   }
-  if (should_spawn_evil_fruit(gm) &&
-      rand_range(0, 100) <
-          gm->difficulty.evil_food_spawn_chance) {  // its time to spawn evil
-                                                    // fruit, roll for chance
-    bool valid = false;
-    Pos new_pos = get_pos(gm, &valid);  // get position
-    if (valid) {                        // there may not be space for new fruit
-      size_t free_index = get_free_index(gm);  // free index in the fruits array
-      gm->fruits[free_index] = (Fruit){.pos = new_pos,  // spawn fruit
-                                       .is_evil = true,
-                                       .ttl = gm->difficulty.evil_fruit_ttl,
-                                       .enabled = true};
-      gm->evil_fruit_count++;
-    }
+  bool valid = false;
+  Pos new_pos = get_pos(gm, &valid);  // get position
+  uint8_t slot;
+  if (!valid ||  // there may not be space for new fruit
+      !fruit_pool_alloc(&gm->fruits, &slot)) {
+    return;
   }
+  gm->fruits.slots[slot] = (Fruit){.pos = new_pos, .is_evil = is_evil};
+  fruit_cell_set(gm, cell_index(new_pos), slot);
+  mark_dirty(gm, cell_index(new_pos));
+  (*count)++;
+  // gone on the ttl-th tick counting the one it was spawned on
+  uint32_t ttl = logic_ticks(is_evil ? d->evil_fruit_ttl_ms : d->fruit_ttl_ms);
+  sched_at(&gm->sched, EV_EXPIRE + slot, ttl > 1 ? ttl - 1 : 1);
 }
 
 /**
- * @brief Moves the snake in the game based on the current direction queue.
- * Also handles snake growth or shrinkage based on buffered length.
+ * @brief Rolls for a new fruit and places it on a free cell, called every
+ * food_ms (evil_food_ms). The fruit gets its expiry scheduled.
  * @param gm Pointer to the GameManager structure.
- * @param direction Pointer to the direction queue.
+ * @param is_evil Whether to spawn an evil fruit.
  */
-void move_snake(GameManager *gm, Queue *direction) {
+void spawn_fruit(GameManager *gm, bool is_evil) {
+  if (gm == NULL) {
+    return;
+  }
+  spawn_fruit_k(gm, is_evil, &gm->difficulty);
+}
+
+// Body of move_snake
+KERNEL_INLINE void move_snake_k(GameManager *gm, Queue *direction) {
   Direction next_dir = gm->snake.dir.name;
   queue_pop(direction, &next_dir);  // invariant if empty
   gm->snake.dir = DIR_DELTA[next_dir];
 
   // Increment snake from length buffer
+  size_t old_len = gm->snake.len;
   if (gm->buffered_len > 0) {
     if (gm->snake.len < MAX_GAME_ARRAY_LEN) {
       gm->snake.len++;  // means it will get redrawn at the end
@@ -340,14 +319,289 @@ void move_snake(GameManager *gm, Queue *direction) {
     gm->buffered_len++;
   }
 
-  for (int i = gm->snake.len - 1; i > 0; i--) {
-    gm->snake.body[i] = gm->snake.body[i - 1];
+  // free the cells dropped off the tail (none when growing, two when
+  // shrinking) before the head moves, so following the tail is not a hit
+  size_t kept = gm->snake.len ? gm->snake.len - 1 : 0;
+  for (size_t i = kept; i < old_len; ++i) {
+    size_t cell = cell_index(*snake_segment(&gm->snake, i));
+    occ_clear(gm->snake_occ, cell);
+    mark_dirty(gm, cell);
+  }
+
+  // new head --- the ring buffer moves the head index one slot back, the
+  // rest of the body stays where it is and the old tail drops off the end
+  Pos head = *snake_segment(&gm->snake, 0);
+  mark_dirty(gm, cell_index(head));  // head color turns into body color
+  head.r = (head.r + gm->snake.dir.pos.r + ROWS) % ROWS;
+  head.c = (head.c + gm->snake.dir.pos.c + COLS) % COLS;
+  gm->snake.head = gm->snake.head ? gm->snake.head - 1u : MAX_GAME_ARRAY_LEN - 1;
+  gm->snake.body[gm->snake.head] = head;
+  mark_dirty(gm, cell_index(head));
+  if (gm->snake.len > 0) {
+    size_t cell = cell_index(head);
+    gm->self_hit = occ_test(gm->snake_occ, cell);
+    occ_set(gm->snake_occ, cell);
+  }
+}
+
+/**
+ * @brief Moves the snake in the game based on the current direction queue.
+ * Also handles snake growth or shrinkage based on buffered length.
+ * @param gm Pointer to the GameManager structure.
+ * @param direction Pointer to the direction queue.
+ */
+void move_snake(GameManager *gm, Queue *direction) {
+  move_snake_k(gm, direction);
+}
+
+/**
+ * @brief Recomputes the snake occupancy bitmap and the per-cell fruit index
+ * from the snake body and the fruit pool. Needed whenever those are set up
+ * directly (game init), the game functions keep both up to date on their own.
+ * @param gm Pointer to the GameManager structure.
+ */
+void occupancy_rebuild(GameManager *gm) {
+  if (gm == NULL) return;
+  memset(gm->snake_occ, 0, sizeof(gm->snake_occ));
+  memset(gm->fruit_occ, 0, sizeof(gm->fruit_occ));
+  memset(gm->fruit_at, 0, sizeof(gm->fruit_at));
+  gm->self_hit = false;
+  for (size_t i = 0; i < gm->snake.len; ++i) {
+    size_t cell = cell_index(*snake_segment(&gm->snake, i));
+    if (i > 0 && cell == cell_index(*snake_segment(&gm->snake, 0))) {
+      gm->self_hit = true;
+    }
+    occ_set(gm->snake_occ, cell);
+  }
+  for (size_t i = 0; i < fruit_pool_count(&gm->fruits); ++i) {
+    fruit_cell_set(gm, cell_index(fruit_pool_active(&gm->fruits, i)->pos),
+                   gm->fruits.active[i]);
+  }
+}
+
+/**
+ * @brief Sets up a new game: the snake at its minimal length in the middle of
+ * the board heading right, no fruits, and the first move and spawn rolls
+ * scheduled.
+ * @param gm Pointer to the GameManager structure.
+ * @param difficulty Settings of the new game.
+ * @param seed Seed of the fruit rolls, the same seed and inputs replay the
+ * same game.
+ */
+void game_reset(GameManager *gm, const Dif *difficulty, uint32_t seed) {
+  if (gm == NULL || difficulty == NULL) return;
+  Direction start_dir = DIR_RIGHT;
+  // initialize the snake body and position to the min length for the difficulty
+  game_set_difficulty(gm, difficulty);
+  // the min snake length can't be larger than the display width minus 2
+  // if not respected udefined behavior
+  int max_idx =
+      gm->difficulty.min_snake_len > COLS  // keep one pixel to the right free
+          ? COLS - 1                       //  one pixel from the right
+          : gm->difficulty.min_snake_len - 1;  // idx
+
+  gm->snake.head = 0;
+  for (int i = 0; i <= max_idx; ++i) {
+    *snake_segment(&gm->snake, (size_t)(max_idx - i)) =
+        (Pos){ROWS / 2, i};  // keep one pixel to each side free
+  }
+  // initialize snake size
+  gm->snake.len = max_idx + 1;
+  gm->snake.dir = DIR_DELTA[start_dir];
+  gm->fruit_count = 0;
+  gm->evil_fruit_count = 0;
+  gm->buffered_len = 0;
+  fruit_pool_init(&gm->fruits);
+  occupancy_rebuild(gm);
+  gm->seed = seed;
+  rng_seed(&gm->rng, seed);
+
+  gm->dirty_count = 0;
+  gm->dirty_full = true;  // nothing of the previous game may stay on screen
+
+  sched_init(&gm->sched);
+  sched_at(&gm->sched, EV_MOVE, logic_ticks(gm->difficulty.move_ms));
+  sched_at(&gm->sched, EV_FOOD, logic_ticks(gm->difficulty.food_ms));
+  sched_at(&gm->sched, EV_EVIL_FOOD, logic_ticks(gm->difficulty.evil_food_ms));
+}
+
+// Body of game_tick for the settings d
+KERNEL_INLINE State game_tick_k(GameManager *gm, Queue *direction,
+                                const Dif *d) {
+  uint8_t due[SCHED_EVENTS];
+  size_t n = sched_advance(&gm->sched, due);
+  for (size_t i = 0; i < n; ++i) {
+    uint8_t event = due[i];
+    if (!sched_fired(&gm->sched, event)) {
+      continue;  // cancelled earlier in this tick, e.g. the fruit got eaten
+    }
+    switch (event) {
+      case EV_MOVE: {
+        sched_at(&gm->sched, EV_MOVE, logic_ticks(d->move_ms));
+        move_snake_k(gm, direction);
+        State res = check_conditions_k(gm, d);
+        if (res != GAME_RUNNING) {  // game over or won
+          return res;
+        }
+        break;
+      }
+      case EV_FOOD:
+        sched_at(&gm->sched, EV_FOOD, logic_ticks(d->food_ms));
+        spawn_fruit_k(gm, false, d);
+        break;
+      case EV_EVIL_FOOD:
+        sched_at(&gm->sched, EV_EVIL_FOOD, logic_ticks(d->evil_food_ms));
+        spawn_fruit_k(gm, true, d);
+        break;
+      default:
+        expire_fruit(gm, event - EV_EXPIRE);
+        break;
+    }
+  }
+  return GAME_RUNNING;
+}
+
+// The entries of DIFFICULTIES, visible here so the kernels fold them
+static const Dif TICK_EASY_DIF = DIF_EASY_INIT;
+static const Dif TICK_MEDIUM_DIF = DIF_MEDIUM_INIT;
+static const Dif TICK_HARD_DIF = DIF_HARD_INIT;
+
+// Any difficulty, read from the game
+static State tick_generic(GameManager *gm, Queue *direction) {
+  return game_tick_k(gm, direction, &gm->difficulty);
+}
+
+static State tick_easy(GameManager *gm, Queue *direction) {
+  return game_tick_k(gm, direction, &TICK_EASY_DIF);
+}
+
+static State tick_medium(GameManager *gm, Queue *direction) {
+  return game_tick_k(gm, direction, &TICK_MEDIUM_DIF);
+}
+
+static State tick_hard(GameManager *gm, Queue *direction) {
+  return game_tick_k(gm, direction, &TICK_HARD_DIF);
+}
+
+static bool dif_equal(const Dif *a, const Dif *b) {
+  return a->name == b->name && a->move_ms == b->move_ms &&
+         a->food_ms == b->food_ms && a->evil_food_ms == b->evil_food_ms &&
+         a->food_spawn_chance == b->food_spawn_chance &&
+         a->evil_food_spawn_chance == b->evil_food_spawn_chance &&
+         a->max_fruit == b->max_fruit &&
+         a->max_evil_fruit == b->max_evil_fruit &&
+         a->fruit_ttl_ms == b->fruit_ttl_ms &&
+         a->evil_fruit_ttl_ms == b->evil_fruit_ttl_ms &&
+         a->winning_len == b->winning_len &&
+         a->min_snake_len == b->min_snake_len &&
+         a->good_inc == b->good_inc && a->evil_dec == b->evil_dec;
+}
+
+/**
+ * @brief Picks the tick kernel of a difficulty: the specialised one if it is
+ * an unchanged entry of DIFFICULTIES, the generic one otherwise.
+ * @param d Settings of the game.
+ * @return The kernel for GameManager.kernel.
+ */
+TickKernel tick_kernel_for(const Dif *d) {
+  static const Dif *const kernels[] = {
+      [TICK_EASY] = &TICK_EASY_DIF,
+      [TICK_MEDIUM] = &TICK_MEDIUM_DIF,
+      [TICK_HARD] = &TICK_HARD_DIF,
+  };
+  if (d == NULL) return TICK_GENERIC;
+  for (int k = TICK_EASY; k <= TICK_HARD; ++k) {
+    if (dif_equal(d, kernels[k])) return (TickKernel)k;
+  }
+  return TICK_GENERIC;
+}
+
+/**
+ * @brief Sets the difficulty of the game together with its tick kernel. Any
+ * change of gm->difficulty has to go through here (or game_reset), a kernel
+ * of another entry would keep playing its own settings.
+ * @param gm Pointer to the GameManager structure.
+ * @param difficulty The new settings.
+ */
+void game_set_difficulty(GameManager *gm, const Dif *difficulty) {
+  if (gm == NULL || difficulty == NULL) return;
+  gm->difficulty = *difficulty;
+  gm->kernel = tick_kernel_for(&gm->difficulty);
+}
+
+/**
+ * @brief Advances a running game by one logic tick (LOGIC_TICK_MS) and handles
+ * the events due on it: the snake move, the spawn rolls and fruit expiry, in
+ * this order. Runs the kernel game_reset picked, all of them play the same.
+ * @param gm Pointer to the GameManager structure.
+ * @param direction Pointer to the direction queue.
+ * @return GAME_RUNNING, or GAME_WON / GAME_LOST when the move ended the game.
+ */
+State game_tick(GameManager *gm, Queue *direction) {
+  if (gm == NULL) {
+    return GAME_RUNNING;
+  }
+#if TICK_KERNEL_CHECK
+  // the generic kernel plays any settings, a specialised one only its own
+  assert(gm->kernel == TICK_GENERIC ||
+         gm->kernel == tick_kernel_for(&gm->difficulty));
+#endif
+  switch (gm->kernel) {
+    case TICK_EASY:
+      return tick_easy(gm, direction);
+    case TICK_MEDIUM:
+      return tick_medium(gm, direction);
+    case TICK_HARD:
+      return tick_hard(gm, direction);
+    default:
+      return tick_generic(gm, direction);
+  }
+}
+
+static inline uint32_t fnv_add(uint32_t h, uint32_t v) {
+  for (int i = 0; i < 4; ++i) {
+    h = (h ^ (v & 0xFF)) * 16777619u;  // FNV-1a, byte by byte
+    v >>= 8;
+  }
+  return h;
+}
+
+/**
+ * @brief Hashes everything that decides how a game continues: the tick, the
+ * snake, the fruits in pool order, the pending events and the random state.
+ * The draw bookkeeping (dirty cells) is left out. Two games with the same
+ * hash play on identically, replays compare it to the recording.
+ * @param gm Pointer to the GameManager structure.
+ * @return The hash, 0 if gm is NULL.
+ */
+uint32_t game_hash(const GameManager *gm) {
+  if (gm == NULL) return 0;
+  uint32_t h = 2166136261u;
+  h = fnv_add(h, gm->sched.now);
+  for (int i = 0; i < 4; ++i) h = fnv_add(h, gm->rng.s[i]);
+  h = fnv_add(h, gm->difficulty.name);
+  h = fnv_add(h, gm->snake.len);
+  h = fnv_add(h, gm->snake.dir.name);
+  h = fnv_add(h, (uint32_t)gm->buffered_len);
+  size_t idx = gm->snake.head;
+  for (size_t i = 0; i < gm->snake.len; ++i) {
+    const Pos *p = &gm->snake.body[idx];
+    h = fnv_add(h, ((uint32_t)(uint16_t)p->r << 16) | (uint16_t)p->c);
+    if (++idx == ROWS * COLS) idx = 0;
+  }
+  h = fnv_add(h, gm->fruits.active_count);
+  for (size_t i = 0; i < gm->fruits.active_count; ++i) {
+    uint8_t slot = gm->fruits.active[i];
+    const Fruit *f = &gm->fruits.slots[slot];
+    h = fnv_add(h, slot);
+    h = fnv_add(h, ((uint32_t)(uint16_t)f->pos.r << 16) | (uint16_t)f->pos.c);
+    h = fnv_add(h, f->is_evil);
+  }
+  for (size_t e = 0; e < SCHED_EVENTS; ++e) {
+    const SchedNode *n = &gm->sched.nodes[e];
+    h = fnv_add(h, n->state == SCHED_ARMED ? n->due : UINT32_MAX);
   }
-  // new head
-  gm->snake.body[0].r += gm->snake.dir.pos.r;
-  gm->snake.body[0].c += gm->snake.dir.pos.c;
-  gm->snake.body[0].r = (gm->snake.body[0].r + ROWS) % ROWS;
-  gm->snake.body[0].c = (gm->snake.body[0].c + COLS) % COLS;
+  return h;
 }
 
 /**********************************EOF game.c*********************************/
\ No newline at end of file
@@ -0,0 +1,242 @@
+/**
+ * @file latency.c
+ * @brief Implementation of the input-to-photon latency probes. All stages but
+ * the last are stamped on the game task, the scanner only stamps the frame
+ * boundary of the one frame the game is waiting for, so the two cores share
+ * a single watched sequence number and a timestamp.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "latency.h"
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "frame_buffers.h"
+
+// Presses followed at once, more than the direction queue holds
+#define LAT_PENDING 8  // power of 2
+// Histogram of the total in 256 us units, 8 log-linear buckets per octave
+// (HDR style) up to ~1 s, slower presses land in the last bucket
+#define LAT_UNIT_SHIFT 8
+#define LAT_SUB_BITS 3
+#define LAT_BUCKETS 80
+
+typedef enum { PROBE_BOUND, PROBE_MOVED, PROBE_PUBLISHED } ProbeState;
+
+// A press in flight, t[0] is the button edge, t[s + 1] the end of stage s
+typedef struct {
+  uint32_t t[LAT_STAGES + 1];
+  uint32_t seq;  // frame showing the move, once published
+  uint8_t diff;
+  uint8_t state;
+} Probe;
+
+typedef struct {
+  uint32_t count;
+  uint32_t max_us;
+  uint16_t hist[LAT_BUCKETS];  // saturating
+  uint64_t stage_sum_us[LAT_STAGES];
+  uint32_t stage_max_us[LAT_STAGES];
+} LatStats;
+
+static Probe probes[LAT_PENDING];
+static uint32_t probe_head, probe_tail;  // pushed / finished, game task only
+static LatStats stats[3];
+// Frame the game waits for (0 = none), cleared by the scanner once shown
+static _Atomic uint32_t watch_seq;
+static uint32_t watch_shown_us;  // valid once watch_seq went back to 0
+
+static inline uint32_t now_us(void) { return (uint32_t)esp_timer_get_time(); }
+
+static int bucket_of(uint32_t us) {
+  uint32_t v = us >> LAT_UNIT_SHIFT;
+  if (v < (1u << LAT_SUB_BITS)) return (int)v;
+  int e = 31 - __builtin_clz(v);
+  int b = ((e - LAT_SUB_BITS + 1) << LAT_SUB_BITS) +
+          (int)((v >> (e - LAT_SUB_BITS)) & ((1u << LAT_SUB_BITS) - 1));
+  return b < LAT_BUCKETS ? b : LAT_BUCKETS - 1;
+}
+
+// Middle of a bucket in microseconds
+static uint32_t bucket_mid_us(int b) {
+  if (b < (1 << LAT_SUB_BITS)) {
+    return ((uint32_t)b << LAT_UNIT_SHIFT) + (1u << (LAT_UNIT_SHIFT - 1));
+  }
+  int e = (b >> LAT_SUB_BITS) + LAT_SUB_BITS - 1;
+  uint32_t m = (uint32_t)b & ((1u << LAT_SUB_BITS) - 1);
+  uint32_t low = ((1u << LAT_SUB_BITS) + m) << (e - LAT_SUB_BITS);
+  uint32_t width = 1u << (e - LAT_SUB_BITS);
+  return (low << LAT_UNIT_SHIFT) + (width << (LAT_UNIT_SHIFT - 1));
+}
+
+static void record(const Probe *p) {
+  LatStats *st = &stats[p->diff];
+  uint32_t total = p->t[LAT_STAGES] - p->t[0];
+  st->count++;
+  if (total > st->max_us) st->max_us = total;
+  uint16_t *h = &st->hist[bucket_of(total)];
+  if (*h < UINT16_MAX) (*h)++;
+  for (int s = 0; s < LAT_STAGES; ++s) {
+    uint32_t d = p->t[s + 1] - p->t[s];
+    st->stage_sum_us[s] += d;
+    if (d > st->stage_max_us[s]) st->stage_max_us[s] = d;
+  }
+}
+
+/**
+ * @brief Drops the collected statistics and every press in flight.
+ */
+void latency_reset(void) {
+  latency_cancel();
+  for (int d = 0; d < 3; ++d) stats[d] = (LatStats){0};
+}
+
+/**
+ * @brief Starts following a press, call when the binding queued its direction.
+ * @param diff Difficulty being played.
+ * @param t_press esp_timer time of the button edge.
+ */
+void latency_bound(Difficulty diff, uint32_t t_press) {
+  if (probe_head - probe_tail >= LAT_PENDING) return;  // not followed
+  Probe *p = &probes[probe_head++ & (LAT_PENDING - 1)];
+  p->t[0] = t_press;
+  p->t[LAT_BIND + 1] = now_us();
+  p->diff = (uint8_t)diff;
+  p->state = PROBE_BOUND;
+}
+
+/**
+ * @brief The snake took the oldest queued direction.
+ */
+void latency_moved(void) {
+  for (uint32_t i = probe_tail; i != probe_head; ++i) {
+    Probe *p = &probes[i & (LAT_PENDING - 1)];
+    if (p->state != PROBE_BOUND) continue;
+    p->t[LAT_MOVE + 1] = now_us();
+    p->state = PROBE_MOVED;
+    return;
+  }
+}
+
+// Makes the scanner stamp the oldest published frame not shown yet
+static void arm_watch(void) {
+  if (atomic_load_explicit(&watch_seq, memory_order_acquire) != 0) return;
+  if (probe_tail == probe_head) return;
+  Probe *p = &probes[probe_tail & (LAT_PENDING - 1)];
+  if (p->state != PROBE_PUBLISHED) return;
+  atomic_store_explicit(&watch_seq, p->seq, memory_order_release);
+  if ((int32_t)(fb_shown_seq() - p->seq) >= 0) {
+    // shown before the watch was up, this tick is the best estimate
+    if (atomic_exchange(&watch_seq, 0) != 0) watch_shown_us = now_us();
+  }
+}
+
+/**
+ * @brief A frame was handed to the scanner, the moved presses are on it.
+ * @param seq Sequence number from fb_publish.
+ */
+void latency_published(uint32_t seq) {
+  uint32_t t = now_us();
+  for (uint32_t i = probe_tail; i != probe_head; ++i) {
+    Probe *p = &probes[i & (LAT_PENDING - 1)];
+    if (p->state != PROBE_MOVED) continue;
+    p->t[LAT_PUBLISH + 1] = t;
+    p->seq = seq;
+    p->state = PROBE_PUBLISHED;
+  }
+  arm_watch();
+}
+
+/**
+ * @brief Finishes the presses the scanner has shown, call every game tick.
+ */
+void latency_poll(void) {
+  while (probe_tail != probe_head) {
+    Probe *p = &probes[probe_tail & (LAT_PENDING - 1)];
+    if (p->state != PROBE_PUBLISHED) break;
+    uint32_t watched = atomic_load_explicit(&watch_seq, memory_order_acquire);
+    if (watched != 0) break;  // not shown yet
+    p->t[LAT_SHOW + 1] = watch_shown_us;
+    record(p);
+    probe_tail++;
+    // presses on the same frame were shown with it, at the same time
+    Probe *next = &probes[probe_tail & (LAT_PENDING - 1)];
+    if (probe_tail != probe_head && next->state == PROBE_PUBLISHED &&
+        next->seq == p->seq) {
+      continue;
+    }
+    arm_watch();
+  }
+}
+
+/**
+ * @brief Forgets the presses in flight, their moves will never be shown (the
+ * game ended or restarted).
+ */
+void latency_cancel(void) {
+  probe_tail = probe_head;
+  atomic_store_explicit(&watch_seq, 0, memory_order_release);
+}
+
+/**
+ * @brief Scanner side, call when a new frame was taken at the frame boundary.
+ * @param seq Sequence number of the frame now shown.
+ */
+void IRAM_ATTR latency_frame_shown(uint32_t seq) {
+  uint32_t watched = atomic_load_explicit(&watch_seq, memory_order_relaxed);
+  if (watched == 0 || (int32_t)(seq - watched) < 0) return;
+  watch_shown_us = now_us();
+  atomic_store_explicit(&watch_seq, 0, memory_order_release);
+}
+
+/**
+ * @brief Summarises the presses of one difficulty.
+ */
+void latency_report(Difficulty diff, LatReport *out) {
+  if (out == NULL || (unsigned)diff > DIFF_HARD) return;
+  const LatStats *st = &stats[diff];
+  *out = (LatReport){.count = st->count, .max_us = st->max_us};
+  if (st->count == 0) return;
+  uint32_t need50 = (st->count + 1) / 2;
+  uint32_t need99 = st->count - st->count / 100;
+  uint32_t seen = 0;
+  for (int b = 0; b < LAT_BUCKETS; ++b) {
+    if (st->hist[b] == 0) continue;
+    seen += st->hist[b];
+    if (out->p50_us == 0 && seen >= need50) out->p50_us = bucket_mid_us(b);
+    if (seen >= need99) {
+      out->p99_us = bucket_mid_us(b);
+      break;
+    }
+  }
+  // the bucket middle may overshoot the exact maximum
+  if (out->p50_us > st->max_us) out->p50_us = st->max_us;
+  if (out->p99_us > st->max_us) out->p99_us = st->max_us;
+  for (int s = 0; s < LAT_STAGES; ++s) {
+    out->stage_mean_us[s] = (uint32_t)(st->stage_sum_us[s] / st->count);
+    out->stage_max_us[s] = st->stage_max_us[s];
+  }
+}
+
+/**
+ * @brief Prints the latency of every difficulty, in milliseconds.
+ */
+void latency_print(void) {
+  static const char *const names[3] = {"easy", "medium", "hard"};
+  printf("latency  presses    p50    p99    max | bind  move  publ  show (mean ms)\n");
+  for (int d = DIFF_EASY; d <= DIFF_HARD; ++d) {
+    LatReport r;
+    latency_report((Difficulty)d, &r);
+    printf("%-7s %8lu %6.1f %6.1f %6.1f |", names[d], (unsigned long)r.count,
+           r.p50_us / 1000.0, r.p99_us / 1000.0, r.max_us / 1000.0);
+    for (int s = 0; s < LAT_STAGES; ++s) {
+      printf(" %5.1f", r.stage_mean_us[s] / 1000.0);
+    }
+    putchar('\n');
+  }
+}
+
+/******************************EOF latency.c*******************************/
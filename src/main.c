@@ -10,29 +10,42 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "brightness.h"
+#include "console.h"
 #include "dir_queue.h"
 #include "draw.h"
 #include "driver/gpio.h"
+#include "driver/gptimer.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 #include "esp_timer.h"
+#include "event_ring.h"
+#include "fast_gpio.h"
+#include "frame_buffers.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "game.h"
 #include "globals.h"
+#include "esp_random.h"
+#include "latency.h"
 #include "models.h"
+#include "pins.h"
+#include "record.h"
+#include "scan_prof.h"
 #include "tlc5947.h"
 #include "utils.h"
 
 // ==== SIGNALS AND GLOBALS ====
 Queue direction = {.q = {}, .head = 0, .tail = 0};
+EventRing button_events;
 GameManager gm;
-static volatile bool game_start_requested = false;
-static volatile bool idle_requested = false;
-static volatile bool next_difficulty_requested = false;
-static volatile bool prev_difficulty_requested = false;
-static volatile bool game_restart_requested = false;
-volatile bool fb_swap_pending = false;  // used by draw and scan to coordinate
-                                        // frame swapping at frame boundary;
-static const float brightness = 0.5;
+// Set by the bindings and consumed by the state functions, both on the game
+// task
+static bool game_start_requested = false;
+static bool idle_requested = false;
+static bool next_difficulty_requested = false;
+static bool prev_difficulty_requested = false;
+static bool game_restart_requested = false;
 
 /************************** DISCLAIMER ******************************
  * The following code is taken from the example project attached to *
@@ -41,42 +54,54 @@ static const float brightness = 0.5;
  * The copied section ends with asterisk styled comment.            *
  ********************************************************************/
 
-// ==== PINY 74HCT154 ====
-// Adresové vstupy: A = ADDR0, B = ADDR1, C = ADDR2, D = ADDR3
-#define HCT154_ADDR0 25
-#define HCT154_ADDR1 17
-#define HCT154_ADDR2 16
-#define HCT154_ADDR3 27
-// COL_EN = společné povolení výstupů (invertované řízení):
-//   HIGH = všechny sloupce vypnuté
-//   LOW  = dekodér aktivní, vybraný sloupec povolen
-#define HCT154_COL_EN 14
-// Buttons
-#define HTC154_SW1 22
-#define HTC154_SW2 21
-#define HTC154_SW3 26
-#define HTC154_SW4 4
-// ==== TLC5947 PINY ====
-#define TLC_MOSI 23
-#define TLC_SCLK 18
-#define TLC_XLAT 13
-#define TLC_BLANK 12
+// Piny 74HCT154, tlačítek a TLC5947 jsou v pins.h
 // Cílová frame rate a odvozené časy
 #define FRAME_RATE_HZ 50
-#define GAME_RATE_HZ                                                       \
-  20 /* the game logic updates at 20 Hz --- CAREFUL the game difficulty is \
-tied to this */
+// The game logic runs at LOGIC_RATE_HZ and frames are drawn at RENDER_RATE_HZ
+// (models.h), the difficulty table is in ms so neither changes the gameplay
+#define LOGIC_TICK_US (LOGIC_TICK_MS * 1000)
+// After a longer stall the logic skips ahead instead of catching up
+#define LOGIC_MAX_LAG_US 250000
+// Log of the recorded game, about one byte per press (record.h)
+#define RECORD_LOG_BYTES 1024
 #define COL_DWELL_US (1000000 / (FRAME_RATE_HZ * COLS))
-// --- 16bit framebuffer (hodnoty 0..4095) ---
-rgb16_t fb_buf0[ROWS][COLS];            // storage buffer 0
-rgb16_t fb_buf1[ROWS][COLS];            // storage buffer 1
-rgb16_t (*fb_draw)[COLS] = fb_buf0;     // For drawing
-rgb16_t (*fb_display)[COLS] = fb_buf1;  // For displaying
-rgb16_t fb0[ROWS][COLS];                // baseline kopie pro obnovení
+// 1 = all columns are packed into ready-to-send SPI frames once per frame
+// swap, 0 = every scan tick loads and packs its column (the original path)
+#ifndef SCAN_PREPACKED
+#define SCAN_PREPACKED 1
+#endif
+// 1 = the next column is shifted in over DMA while the current one is lit,
+// a scan tick then only latches and switches the column (needs SCAN_PREPACKED)
+#ifndef SCAN_PIPELINED
+#define SCAN_PIPELINED 1
+#endif
+#if SCAN_PIPELINED && !SCAN_PREPACKED
+#error "SCAN_PIPELINED requires SCAN_PREPACKED"
+#endif
+// The scan owns one core and the game loop the other, so a slow game tick
+// can not delay a column. They only meet at the frame buffers
+// (fb_publish/fb_acquire) and the brightness tables (brightness_acquire); the
+// buttons, the console and the game stay on the game core.
+#define SCAN_CORE 1
+#define GAME_CORE 0
+#define SCAN_TASK_PRIO (configMAX_PRIORITIES - 1)  // nothing preempts a column
+#define GAME_TASK_PRIO 5                           // above the console (main)
+#define SCAN_TASK_STACK 3072
+#define GAME_TASK_STACK 4096
+#define SCAN_TIMER_HZ 1000000  // 1 us per gptimer tick
+static TaskHandle_t scan_task_handle;
+// --- framebuffers of palette indices (frame_buffers.c), colors in PALETTE ---
+// PALETTE with the brightness table applied, rebuilt when the table changes
+static rgb16_t palette_dim[PALETTE_SIZE];
 // Ovladač TLC
 static tlc5947_t tlc;
 // Stav multiplexu
 static volatile int cur_col = -1;
+#if SCAN_PREPACKED
+// Packed TLC bitstream of every column of fb_display [COLS][tlc.frame_bytes],
+// DMA capable so the pipelined scan can shift straight from it
+static uint8_t *col_tx;
+#endif
 
 // ====== MAPOVÁNÍ KANÁLŮ TLC5947 ======
 // R: 1, 4, 7, 10, 13, 16, 19, 22
@@ -91,64 +116,180 @@ static inline int ch_g(int row) { return MAP_G[row & 7]; }
 static inline int ch_b(int row) { return MAP_B[row & 7]; }
 
 // === Pomocné: GPIO 74HCT154 ===
-static inline void col_disable_all(void) { gpio_set_level(HCT154_COL_EN, 1); }
+#define HCT154_ADDR_MASK                                  \
+  (FAST_GPIO_BIT(HCT154_ADDR0) | FAST_GPIO_BIT(HCT154_ADDR1) | \
+   FAST_GPIO_BIT(HCT154_ADDR2) | FAST_GPIO_BIT(HCT154_ADDR3))
+// Address pins to drive high for every column, the rest of the mask goes low
+#define HCT154_ADDR_BITS(col)                                    \
+  ((((col) >> 0) & 1 ? FAST_GPIO_BIT(HCT154_ADDR0) : 0) |        \
+   (((col) >> 1) & 1 ? FAST_GPIO_BIT(HCT154_ADDR1) : 0) |        \
+   (((col) >> 2) & 1 ? FAST_GPIO_BIT(HCT154_ADDR2) : 0) |        \
+   (((col) >> 3) & 1 ? FAST_GPIO_BIT(HCT154_ADDR3) : 0))
+static const DRAM_ATTR uint32_t COL_ADDR_BITS[16] = {
+    HCT154_ADDR_BITS(0),  HCT154_ADDR_BITS(1),  HCT154_ADDR_BITS(2),
+    HCT154_ADDR_BITS(3),  HCT154_ADDR_BITS(4),  HCT154_ADDR_BITS(5),
+    HCT154_ADDR_BITS(6),  HCT154_ADDR_BITS(7),  HCT154_ADDR_BITS(8),
+    HCT154_ADDR_BITS(9),  HCT154_ADDR_BITS(10), HCT154_ADDR_BITS(11),
+    HCT154_ADDR_BITS(12), HCT154_ADDR_BITS(13), HCT154_ADDR_BITS(14),
+    HCT154_ADDR_BITS(15)};
+
+static inline void col_disable_all(void) {
+  fast_gpio_set(FAST_GPIO_BIT(HCT154_COL_EN));
+}
 static inline void col_enable_selected(void) {
-  gpio_set_level(HCT154_COL_EN, 0);
+  fast_gpio_clear(FAST_GPIO_BIT(HCT154_COL_EN));
 }
 static inline void col_select(int col) {
-  gpio_set_level(HCT154_ADDR0, (col >> 0) & 1);
-  gpio_set_level(HCT154_ADDR1, (col >> 1) & 1);
-  gpio_set_level(HCT154_ADDR2, (col >> 2) & 1);
-  gpio_set_level(HCT154_ADDR3, (col >> 3) & 1);
+  fast_gpio_write(HCT154_ADDR_MASK, COL_ADDR_BITS[col & 15]);
+}
+// Applies the current brightness table to the palette, a dozen colors
+// instead of every pixel
+static void palette_refresh(void) {
+  for (int i = 0; i < PALETTE_SIZE; ++i) {
+    // držíme 0..4095; horní bity odmaskujeme pro jistotu
+    palette_dim[i] = (rgb16_t){brightness_apply(PALETTE[i].r & 0x0FFF),
+                               brightness_apply(PALETTE[i].g & 0x0FFF),
+                               brightness_apply(PALETTE[i].b & 0x0FFF)};
+  }
 }
+
 // Naplní TLC hodnotami pro daný sloupec; 'lit'==false sloupec zhasne
 static void load_column_into_tlc(int col, bool lit) {
   for (int r = 0; r < ROWS; ++r) {
-    rgb16_t px = fb_display[r][col];
-    // držíme 0..4095; horní bity odmaskujeme pro jistotu
-    uint16_t rv = lit ? (px.r & 0x0FFF) : 0;
-    uint16_t gv = lit ? (px.g & 0x0FFF) : 0;
-    uint16_t bv = lit ? (px.b & 0x0FFF) : 0;
-    tlc5947_set_ch(&tlc, ch_r(r), rv * brightness);
-    tlc5947_set_ch(&tlc, ch_g(r), gv * brightness);
-    tlc5947_set_ch(&tlc, ch_b(r), bv * brightness);
+    rgb16_t px = palette_dim[lit ? fb_display[r][col] : BLACK_COLOR];
+    tlc5947_set_ch(&tlc, ch_r(r), px.r);
+    tlc5947_set_ch(&tlc, ch_g(r), px.g);
+    tlc5947_set_ch(&tlc, ch_b(r), px.b);
+  }
+}
+
+#if SCAN_PREPACKED
+// Converts the whole fb_display into per-column SPI frames
+static void prepack_columns(void) {
+  for (int c = 0; c < COLS; ++c) {
+    load_column_into_tlc(c, true);
+    tlc5947_pack(&tlc, col_tx + c * tlc.frame_bytes);
+  }
+}
+#endif
+
+// Switches to the newest published frame --- only call at the frame
+// boundary, ensures the buffer is consistent throughout the frame
+static inline void frame_boundary(void) {
+  bool swapped = fb_acquire();
+  if (swapped) latency_frame_shown(fb_shown_seq());
+  bool restyled = brightness_acquire();
+  if (restyled) palette_refresh();
+#if SCAN_PREPACKED
+  // the only place a frame gets converted: new frame or new brightness table
+  if (swapped || restyled) {
+    prepack_columns();
   }
+#endif
 }
 
+#if SCAN_PIPELINED
 // Periodický multiplex (každých COL_DWELL_US)
-static void IRAM_ATTR scan_timer_cb(void *arg) {
+// The data of cur_col was shifted in during the previous dwell, so the tick
+// only latches it, switches the column and starts shifting the next one.
+static void IRAM_ATTR scan_step(ScanProfRun *prof) {
+  tlc5947_shift_wait(&tlc);  // long done, the frame is ~10 us on the wire
+  scan_prof_mark(prof, SP_SPI);
+  col_disable_all();         // během latche nic nesvítí
+  cur_col = (cur_col + 1) % COLS;
+  tlc5947_latch(&tlc, true);  // BLANK-sync latch
+  col_select(cur_col);
+  col_enable_selected();
+  scan_prof_mark(prof, SP_GPIO);
+
+  int next_col = (cur_col + 1) % COLS;
+  if (next_col == 0) {
+    frame_boundary();
+    scan_prof_mark(prof, SP_FRAME);
+  }
+  tlc5947_shift_start(&tlc, col_tx + next_col * tlc.frame_bytes);
+  scan_prof_mark(prof, SP_SPI);
+}
+#else
+// Periodický multiplex (každých COL_DWELL_US)
+static void IRAM_ATTR scan_step(ScanProfRun *prof) {
   col_disable_all();  // během latche nic nesvítí
   cur_col = (cur_col + 1) % COLS;
+  scan_prof_mark(prof, SP_GPIO);
 
-  // vblank --- only swap the buffers at the frame boundary --- ensures the
-  // buffer is consistent throughout the frame
-  if (cur_col == 0 && fb_swap_pending) {
-    rgb16_t(*tmp)[COLS] = fb_display;
-    fb_display = fb_draw;
-    fb_draw = tmp;
-    fb_swap_pending = false;
+  if (cur_col == 0) {
+    frame_boundary();
+    scan_prof_mark(prof, SP_FRAME);
   }
 
+#if SCAN_PREPACKED
+  tlc5947_update_packed(&tlc, col_tx + cur_col * tlc.frame_bytes, true);
+#else
   bool lit = true;
   load_column_into_tlc(cur_col, lit);
-  tlc5947_update(&tlc, true);  // BLANK-sync latch
+  scan_prof_mark(prof, SP_LOAD);
+  tlc5947_pack(&tlc, tlc.tx);  // what tlc5947_update does, split to profile
+  scan_prof_mark(prof, SP_PACK);
+  tlc5947_update_packed(&tlc, tlc.tx, true);  // BLANK-sync latch
+#endif
+  scan_prof_mark(prof, SP_SPI);
 
   col_select(cur_col);
   col_enable_selected();
+  scan_prof_mark(prof, SP_GPIO);
 }
+#endif
 
-static void fb_init_content(void) {
-  for (int c = 0; c < COLS; ++c) {
-    for (int r = 0; r < ROWS; ++r) {
-      fb_draw[r][c] = (rgb16_t){0, 0, 0};
-    }
-  }
-  // založ baseline kopii
-  memcpy(fb0, fb_draw, sizeof(fb0));
-  memcpy(fb_display, fb_draw, sizeof(fb_buf0));
+/**********************END OF THE COPIED SECTION********************/
+
+static volatile uint32_t scan_alarm_cycles;  // when the last alarm fired
+
+// Alarm every COL_DWELL_US, wakes the scan task which then preempts anything
+// else on its core
+static bool IRAM_ATTR scan_alarm_isr(gptimer_handle_t timer,
+                                     const gptimer_alarm_event_data_t *edata,
+                                     void *arg) {
+  (void)timer;
+  (void)edata;
+  (void)arg;
+  scan_alarm_cycles = esp_cpu_get_cycle_count();
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(scan_task_handle, &woken);
+  return woken == pdTRUE;  // switch to the scan task on return
 }
 
-/**********************END OF THE COPIED SECTION********************/
+// Scan task, pinned to SCAN_CORE. The timer is created here so that its
+// interrupt is allocated on the same core.
+static void scan_task(void *arg) {
+  (void)arg;
+#if SCAN_PIPELINED
+  ESP_ERROR_CHECK(tlc5947_pipeline_begin(&tlc));
+  ESP_ERROR_CHECK(tlc5947_shift_start(&tlc, col_tx));  // column 0 goes first
+#endif
+  gptimer_handle_t timer;
+  const gptimer_config_t timer_cfg = {.clk_src = GPTIMER_CLK_SRC_DEFAULT,
+                                      .direction = GPTIMER_COUNT_UP,
+                                      .resolution_hz = SCAN_TIMER_HZ};
+  const gptimer_event_callbacks_t cbs = {.on_alarm = scan_alarm_isr};
+  const gptimer_alarm_config_t alarm = {
+      .alarm_count = (uint64_t)COL_DWELL_US * SCAN_TIMER_HZ / 1000000,
+      .reload_count = 0,
+      .flags.auto_reload_on_alarm = true};
+  scan_prof_init(COL_DWELL_US);
+  ESP_ERROR_CHECK(gptimer_new_timer(&timer_cfg, &timer));
+  ESP_ERROR_CHECK(gptimer_register_event_callbacks(timer, &cbs, NULL));
+  ESP_ERROR_CHECK(gptimer_set_alarm_action(timer, &alarm));
+  ESP_ERROR_CHECK(gptimer_enable(timer));
+  ESP_ERROR_CHECK(gptimer_start(timer));
+  while (1) {
+    // missed alarms collapse into one step, the profile counts them
+    uint32_t alarms = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    ScanProfRun prof;
+    scan_prof_begin(&prof, scan_alarm_cycles);
+    scan_step(&prof);
+    scan_prof_end(&prof, alarms);
+  }
+}
 
 // ==== HANDLING BUTTON PRESSES, BUTTON BINDINGS =====
 static void binds_idle(Direction dir) {
@@ -195,71 +336,76 @@ static void binds_end_game(Direction dir) {
 }
 static void binds_running(Direction dir) {
   // during game, all buttons insert direction
-  insert_dir(dir, &gm);
+  record_event(gm.sched.now, dir);
+  insert_dir(&direction, dir, &gm);
 }
 
 // ==== INTERRUPT HANDLER FOR BUTTONS =====
+// Only timestamps the press, everything else happens in handle_buttons
 static void IRAM_ATTR button_isr_handler(void *arg) {
-  /* Handle debouncing and spamming - the time limit depends on game state to
-   * make the game responsive */
-  int max_time = 0;
-  if (gm.state == GAME_IDLE) max_time = 250;
-  if (gm.state == GAME_LOST || gm.state == GAME_WON) max_time = 100;
-  static int64_t last_press = 0;
-  int64_t now = esp_timer_get_time() / 1000;  // in ms
-  if (now - last_press < max_time) {
-    return;
-  }
-  last_press = now;
+  ButtonEvent ev = {.t_us = (uint32_t)esp_timer_get_time(),
+                    .dir = (uint8_t)(uintptr_t)arg};
+  event_ring_push(&button_events, ev);
+}
 
-  // Call appropriate binding based on game state
-  Direction dir = (Direction)(uintptr_t)arg;
-  switch (gm.state) {
-    case GAME_IDLE:
-      binds_idle(dir);
-      break;
-    case GAME_RUNNING:
-      binds_running(dir);
-      break;
-    case GAME_LOST:
-    case GAME_WON:
-      binds_end_game(dir);
-      break;
-    default:
-      break;
+// Handles the presses up to the logic time t_us, on the game task
+static void handle_buttons(uint32_t t_us) {
+  static uint32_t last_press = 0;  // t_us of the last accepted press
+  ButtonEvent ev;
+  while (event_ring_peek(&button_events, &ev) &&
+         (int32_t)(ev.t_us - t_us) <= 0) {
+    event_ring_pop(&button_events, &ev);
+    /* Handle debouncing and spamming - the time limit depends on game state
+     * to make the game responsive */
+    uint32_t max_time = 0;  // in us
+    if (gm.state == GAME_IDLE) max_time = 250000;
+    if (gm.state == GAME_LOST || gm.state == GAME_WON) max_time = 100000;
+    if (ev.t_us - last_press < max_time) continue;
+    last_press = ev.t_us;
+
+    // Call appropriate binding based on game state
+    Direction dir = (Direction)ev.dir;
+    switch (gm.state) {
+      case GAME_IDLE:
+        binds_idle(dir);
+        break;
+      case GAME_RUNNING: {
+        size_t queued = direction.occupied;
+        binds_running(dir);
+        // follow the press to the panel if it made it into the queue
+        if (direction.occupied > queued) {
+          latency_bound(gm.difficulty.name, ev.t_us);
+        }
+        break;
+      }
+      case GAME_LOST:
+      case GAME_WON:
+        binds_end_game(dir);
+        break;
+      default:
+        break;
+    }
   }
 }
 
 // ===== GAME STATE FUNCTIONS =====
 void game_init(Difficulty diff) {
-  Direction start_dir = DIR_RIGHT;
-  // initialize the snake body and position to the min length for the difficulty
-  gm.difficulty = DIFFICULTIES[diff];
-  // the min snake length can't be larger than the display width minus 2
-  // if not respected udefined behavior
-  int max_idx =
-      gm.difficulty.min_snake_len > COLS  // keep one pixel to the right free
-          ? COLS - 1                      //  one pixel from the right
-          : gm.difficulty.min_snake_len - 1;  // idx
-
-  for (size_t i = 0; i <= max_idx; ++i) {
-    gm.snake.body[max_idx - i] =
-        (Pos){ROWS / 2, i};  // keep one pixel to each side free
-  }
-  // initialize snake size
-  gm.snake.len = max_idx + 1;
-  gm.snake.dir = DIR_DELTA[start_dir];
-  gm.fruit_count = 0;
-  gm.evil_fruit_count = 0;
-  gm.buffered_len = 0;
-  memset(gm.fruits, 0, sizeof(gm.fruits));
+  // hardware entropy only picks the seed, the game itself is reproducible
+  game_reset(&gm, &DIFFICULTIES[diff], esp_random());
   queue_clear(&direction);  // clear direction queue
+  latency_cancel();         // the queued presses are gone
   gm.state = GAME_IDLE;
 }
 
+// starts a new game of the difficulty and records it
+static void game_start(Difficulty diff) {
+  game_init(diff);
+  gm.state = GAME_RUNNING;
+  record_start(&gm);
+}
+
 // won state behavior
 void game_won() {
-  draw_won();
   if (idle_requested) {
     idle_requested = false;
     game_init(DIFF_EASY);
@@ -267,14 +413,12 @@ void game_won() {
   }
   if (game_restart_requested) {
     game_restart_requested = false;
-    game_init(gm.difficulty.name);
-    gm.state = GAME_RUNNING;
+    game_start(gm.difficulty.name);
   }
 }
 
 // lost state behavior
 void game_lost() {
-  draw_lost();
   if (idle_requested) {
     idle_requested = false;
     game_init(DIFF_EASY);
@@ -282,55 +426,46 @@ void game_lost() {
   }
   if (game_restart_requested) {
     game_restart_requested = false;
-    game_init(gm.difficulty.name);
-    gm.state = GAME_RUNNING;
+    game_start(gm.difficulty.name);
   }
 }
 
 // idle state behavior
 void game_idle() {
-  draw_idle(&gm);
   // cycling difficulties
   if (next_difficulty_requested) {
-    gm.difficulty = DIFFICULTIES[get_next_difficulty(gm.difficulty.name)];
+    game_set_difficulty(&gm,
+                        &DIFFICULTIES[get_next_difficulty(gm.difficulty.name)]);
     next_difficulty_requested = false;
   }
   if (prev_difficulty_requested) {
-    gm.difficulty = DIFFICULTIES[get_prev_difficulty(gm.difficulty.name)];
+    game_set_difficulty(&gm,
+                        &DIFFICULTIES[get_prev_difficulty(gm.difficulty.name)]);
     prev_difficulty_requested = false;
   }
   if (game_start_requested) {
     game_start_requested = false;
-    game_init(gm.difficulty
-                  .name);  // to re-init with correct values for the difficulty
-    fb_clear();
-    fb_swap();  // clear display before starting
-    gm.state = GAME_RUNNING;
+    game_start(gm.difficulty
+                   .name);  // to re-init with correct values for the difficulty
   }
 }
 
 // running state behavior
 void game_running() {
-  draw_running(&gm);
-  static int frame_counter = 0;
-  frame_counter++;
-  if (frame_counter >= gm.difficulty.move_T) {  // only move the snake sometimes
-                                                // (controlled by difficulty)
-    frame_counter = 0;
-    move_snake(&gm, &direction);
-    State res = check_conditions(&gm);
-    if (res != GAME_RUNNING) {  // game over or won
-      gm.state = res;
-      return;
-    }
+  // moves, spawns and expiry all come from the scheduler
+  size_t queued = direction.occupied;
+  State res = game_tick(&gm, &direction);
+  if (direction.occupied < queued) latency_moved();
+  if (res != GAME_RUNNING) {  // game over or won
+    gm.state = res;
+    latency_cancel();
+    record_finish(&gm);
   }
-  // always spawn and remove fruits --- consistent timing across difficulties
-  spawn_fruit(&gm);
-  remove_expired_fruits(&gm);
 }
 
-// game loop
-static void IRAM_ATTR game_timer_cb(void *arg) {
+// one logic tick, t_us is the time it stands for
+static void logic_step(uint32_t t_us) {
+  handle_buttons(t_us);
   switch (gm.state) {
     case GAME_IDLE:
       game_idle();
@@ -349,6 +484,47 @@ static void IRAM_ATTR game_timer_cb(void *arg) {
   }
 }
 
+// draws the current state, once per frame
+static void render(void) {
+  switch (gm.state) {
+    case GAME_IDLE:
+      draw_idle(&gm);
+      break;
+    case GAME_RUNNING:
+      latency_poll();
+      draw_running(&gm);
+      latency_published(fb_published_seq());
+      break;
+    case GAME_WON:
+      draw_won(&gm);
+      break;
+    case GAME_LOST:
+      draw_lost(&gm);
+      break;
+    default:
+      break;
+  }
+}
+
+// game loop, pinned to GAME_CORE. Wakes at RENDER_RATE_HZ, runs the logic
+// ticks that fell due since the last frame (fixed timestep accumulator) and
+// draws one frame.
+static void game_task(void *arg) {
+  (void)arg;
+  TickType_t last_wake = xTaskGetTickCount();
+  int64_t logic_time = esp_timer_get_time();  // time the logic has reached
+  while (1) {
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(1000 / RENDER_RATE_HZ));
+    int64_t now = esp_timer_get_time();
+    if (now - logic_time > LOGIC_MAX_LAG_US) logic_time = now - LOGIC_MAX_LAG_US;
+    while (now - logic_time >= LOGIC_TICK_US) {
+      logic_time += LOGIC_TICK_US;
+      logic_step((uint32_t)logic_time);
+    }
+    render();
+  }
+}
+
 /************************** DISCLAIMER *******************************
  * Parts of the app_main function are taken form the example project *
  * attached to the assignment                                     .  *
@@ -380,6 +556,7 @@ void app_main(void) {
   gpio_config(&btn_cfg);
 
   // ISR for buttons
+  event_ring_clear(&button_events);
   gpio_install_isr_service(0);
   gpio_isr_handler_add(HTC154_SW1, button_isr_handler, (void *)DIR_DOWN);
   gpio_isr_handler_add(HTC154_SW2, button_isr_handler, (void *)DIR_UP);
@@ -399,20 +576,31 @@ void app_main(void) {
   tlc5947_fill(&tlc, 0);
   tlc5947_update(&tlc, true);
 
-  fb_init_content();
+  brightness_init(BRIGHTNESS_MAX / 2, GAMMA_LINEAR);
+  brightness_acquire();
+  palette_refresh();
+  fb_init();
+  draw_init();
+#if SCAN_PREPACKED
+  col_tx = (uint8_t *)heap_caps_calloc(COLS, tlc.frame_bytes, MALLOC_CAP_DMA);
+  ESP_ERROR_CHECK(col_tx ? ESP_OK : ESP_ERR_NO_MEM);
+  prepack_columns();
+#endif
+  uint8_t *rec_log =
+      (uint8_t *)heap_caps_malloc(RECORD_LOG_BYTES, MALLOC_CAP_8BIT);
+  record_init(rec_log, rec_log ? RECORD_LOG_BYTES : 0);  // none, no recording
 
-  // Timer for display multiplexing
-  const esp_timer_create_args_t scan_tmr_args = {.callback = &scan_timer_cb,
-                                                 .name = "scan"};
-  const esp_timer_create_args_t frame_tmr_args = {.callback = &game_timer_cb,
-                                                  .name = "game"};
-  esp_timer_handle_t scan_tmr, frame_tmr;
-  ESP_ERROR_CHECK(esp_timer_create(&scan_tmr_args, &scan_tmr));
-  ESP_ERROR_CHECK(esp_timer_create(&frame_tmr_args, &frame_tmr));
-  ESP_ERROR_CHECK(esp_timer_start_periodic(scan_tmr, COL_DWELL_US));
-  ESP_ERROR_CHECK(esp_timer_start_periodic(frame_tmr, 1000000 / GAME_RATE_HZ));
+  // Display multiplexing and the game loop, each on its own core
+  BaseType_t ok = xTaskCreatePinnedToCore(scan_task, "scan", SCAN_TASK_STACK,
+                                          NULL, SCAN_TASK_PRIO,
+                                          &scan_task_handle, SCAN_CORE);
+  ESP_ERROR_CHECK(ok == pdPASS ? ESP_OK : ESP_ERR_NO_MEM);
+  ok = xTaskCreatePinnedToCore(game_task, "game", GAME_TASK_STACK, NULL,
+                               GAME_TASK_PRIO, NULL, GAME_CORE);
+  ESP_ERROR_CHECK(ok == pdPASS ? ESP_OK : ESP_ERR_NO_MEM);
 
   while (1) {
+    console_poll();
     vTaskDelay(pdMS_TO_TICKS(100));
   }
 }
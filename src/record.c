@@ -0,0 +1,175 @@
+/**
+ * @file record.c
+ * @brief Implementation of the game recorder. There is one recording, the
+ * game being played or the last one, written only by the game task. A full
+ * log stops taking events and flags the recording as truncated.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "record.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "game.h"
+
+static uint8_t *log_buf;    // header and events
+static size_t log_cap;
+static size_t log_len;      // bytes written, 0 = nothing recorded yet
+static uint32_t last_tick;  // of the previous event
+static bool recording;      // between record_start and record_finish
+static RecordSink sink;
+
+static void put_u16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+  put_u16(p, (uint16_t)v);
+  put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+  return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return get_u16(p) | (uint32_t)get_u16(p + 2) << 16;
+}
+
+/**
+ * @brief Hands the recorder its log buffer, call once before the first game.
+ * @param buf Buffer for one recording, NULL disables recording.
+ * @param cap Size of buf, at least REC_HEADER_BYTES.
+ */
+void record_init(uint8_t *buf, size_t cap) {
+  recording = false;
+  log_len = 0;
+  log_buf = cap >= REC_HEADER_BYTES ? buf : NULL;
+  // the header counts event bytes in 16 bits
+  log_cap = cap > REC_HEADER_BYTES + UINT16_MAX ? REC_HEADER_BYTES + UINT16_MAX
+                                                : cap;
+}
+
+/**
+ * @brief Sets the function that gets every finished recording, NULL for none.
+ */
+void record_set_sink(RecordSink fn) { sink = fn; }
+
+/**
+ * @brief Starts recording a game, call right after game_reset.
+ * @param gm The new game, its difficulty and seed go to the header.
+ */
+void record_start(const GameManager *gm) {
+  if (log_buf == NULL || gm == NULL) return;
+  uint8_t *h = log_buf;
+  memset(h, 0, REC_HEADER_BYTES);
+  h[0] = 'S';
+  h[1] = 'R';
+  h[2] = REC_VERSION;
+  h[3] = (uint8_t)gm->difficulty.name;
+  h[4] = ROWS;
+  h[5] = COLS;
+  put_u16(h + 6, LOGIC_RATE_HZ);
+  put_u32(h + 8, gm->seed);
+  h[22] = GAME_RUNNING;
+  log_len = REC_HEADER_BYTES;
+  last_tick = 0;
+  recording = true;
+}
+
+/**
+ * @brief Logs a press bound while running.
+ * @param tick Logic ticks the game has run (gm.sched.now) when it was bound.
+ * @param dir The direction handed to insert_dir.
+ */
+void record_event(uint32_t tick, Direction dir) {
+  if (!recording || (log_buf[23] & REC_FLAG_TRUNCATED)) return;
+  uint8_t bytes[5];
+  size_t n = 0;
+  uint32_t v = (tick - last_tick) << 2 | ((uint32_t)dir & 3);
+  do {
+    bytes[n++] = (uint8_t)((v & 0x7F) | (v > 0x7F ? 0x80 : 0));
+    v >>= 7;
+  } while (v);
+  if (log_len + n > log_cap) {
+    log_buf[23] |= REC_FLAG_TRUNCATED;
+    return;
+  }
+  memcpy(log_buf + log_len, bytes, n);
+  log_len += n;
+  last_tick = tick;
+}
+
+/**
+ * @brief Closes the recording when the game is won or lost and passes it to
+ * the sink.
+ * @param gm The finished game.
+ */
+void record_finish(const GameManager *gm) {
+  if (!recording || gm == NULL) return;
+  recording = false;
+  put_u32(log_buf + 12, gm->sched.now);
+  put_u32(log_buf + 16, game_hash(gm));
+  put_u16(log_buf + 20, (uint16_t)(log_len - REC_HEADER_BYTES));
+  log_buf[22] = (uint8_t)gm->state;
+  if (sink != NULL) sink(log_buf, log_len);
+}
+
+/**
+ * @brief The current or last recording.
+ * @param rec Set to the recording, its end fields are only valid once the
+ * game is over.
+ * @return Its length in bytes, 0 if nothing was recorded.
+ */
+size_t record_get(const uint8_t **rec) {
+  if (rec != NULL) *rec = log_buf;
+  if (log_buf != NULL && recording) {
+    put_u16(log_buf + 20, (uint16_t)(log_len - REC_HEADER_BYTES));
+  }
+  return log_buf != NULL ? log_len : 0;
+}
+
+/**
+ * @brief Prints the current or last recording as one "rec <hex>" line, the
+ * format the host replay tool reads. Print between games, a game started
+ * during the print overwrites it.
+ */
+void record_print(void) {
+  const uint8_t *rec;
+  size_t len = record_get(&rec);
+  if (len == 0) {
+    printf("rec      nothing recorded\n");
+    return;
+  }
+  printf("rec ");
+  for (size_t i = 0; i < len; ++i) printf("%02x", rec[i]);
+  putchar('\n');
+}
+
+/**
+ * @brief Decodes and checks the header of a recording.
+ * @param rec The recording.
+ * @param len Its length in bytes.
+ * @param out The decoded header.
+ * @return false if it is not a recording of this version or is cut short.
+ */
+bool rec_parse_header(const uint8_t *rec, size_t len, RecHeader *out) {
+  if (rec == NULL || out == NULL || len < REC_HEADER_BYTES) return false;
+  if (rec[0] != 'S' || rec[1] != 'R' || rec[2] != REC_VERSION) return false;
+  if (rec[3] > DIFF_HARD || rec[22] > GAME_LOST) return false;
+  *out = (RecHeader){.diff = (Difficulty)rec[3],
+                     .rows = rec[4],
+                     .cols = rec[5],
+                     .rate_hz = get_u16(rec + 6),
+                     .seed = get_u32(rec + 8),
+                     .end_tick = get_u32(rec + 12),
+                     .end_hash = get_u32(rec + 16),
+                     .event_bytes = get_u16(rec + 20),
+                     .end_state = (State)rec[22],
+                     .flags = rec[23]};
+  return REC_HEADER_BYTES + (size_t)out->event_bytes <= len;
+}
+
+/*******************************EOF record.c*******************************/
@@ -0,0 +1,127 @@
+/**
+ * @file replay.c
+ * @brief Implementation of the replay. A complete recording (game over, log
+ * not truncated) is verified at its end against the recorded tick, state and
+ * game_hash; others play until their log runs out.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "replay.h"
+
+#include "dir_queue.h"
+#include "game.h"
+#include "utils.h"
+
+static bool complete(const RecHeader *hdr) {
+  return hdr->end_state != GAME_RUNNING && !(hdr->flags & REC_FLAG_TRUNCATED);
+}
+
+// Decodes the next event, false at the end of the log or on a broken varint
+static bool next_event(Replay *rp) {
+  uint32_t v = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (rp->next == rp->end) break;
+    uint8_t b = *rp->next++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      rp->ev_tick += v >> 2;
+      rp->ev_dir = (Direction)(v & 3);
+      return true;
+    }
+  }
+  if (rp->next != rp->end) rp->status = REPLAY_BAD;
+  return false;
+}
+
+static void finish(Replay *rp, ReplayStatus status) {
+  rp->done = true;
+  if (rp->status == REPLAY_OK) rp->status = status;
+}
+
+/**
+ * @brief Starts a replay: checks the recording and resets the game to its
+ * difficulty and seed.
+ * @param rp The replay.
+ * @param rec The recording, must stay valid for the whole replay.
+ * @param len Its length in bytes.
+ * @param gm Game to play it on.
+ * @param queue Direction queue of that game.
+ * @return REPLAY_BAD if it can not be replayed by this build.
+ */
+ReplayStatus replay_open(Replay *rp, const uint8_t *rec, size_t len,
+                         GameManager *gm, Queue *queue) {
+  if (rp == NULL) return REPLAY_BAD;
+  *rp = (Replay){.gm = gm, .queue = queue, .done = true,
+                 .status = REPLAY_BAD};
+  if (gm == NULL || queue == NULL || !rec_parse_header(rec, len, &rp->hdr)) {
+    return REPLAY_BAD;
+  }
+  // the log is in ticks of the recording build on its board
+  if (rp->hdr.rows != ROWS || rp->hdr.cols != COLS ||
+      rp->hdr.rate_hz != LOGIC_RATE_HZ) {
+    return REPLAY_BAD;
+  }
+  rp->next = rec + REC_HEADER_BYTES;
+  rp->end = rp->next + rp->hdr.event_bytes;
+  rp->status = REPLAY_OK;
+  rp->done = false;
+  game_reset(gm, &DIFFICULTIES[rp->hdr.diff], rp->hdr.seed);
+  queue_clear(queue);
+  gm->state = GAME_RUNNING;
+  rp->ev_pending = next_event(rp);
+  return rp->status;
+}
+
+/**
+ * @brief Plays one logic tick: the presses logged for it, then game_tick.
+ * @return The game state after the tick.
+ */
+State replay_tick(Replay *rp) {
+  if (rp == NULL || rp->gm == NULL) return GAME_IDLE;
+  GameManager *gm = rp->gm;
+  if (rp->done) return gm->state;
+  while (rp->ev_pending && rp->ev_tick == gm->sched.now) {
+    insert_dir(rp->queue, rp->ev_dir, gm);
+    rp->ev_pending = next_event(rp);
+  }
+  if (rp->status == REPLAY_BAD ||
+      (rp->ev_pending && rp->ev_tick < gm->sched.now)) {
+    finish(rp, REPLAY_BAD);
+    return gm->state;
+  }
+  State res = game_tick(gm, rp->queue);
+  if (res != GAME_RUNNING) {
+    gm->state = res;
+    if (complete(&rp->hdr) &&
+        (rp->ev_pending || gm->sched.now != rp->hdr.end_tick ||
+         res != rp->hdr.end_state || game_hash(gm) != rp->hdr.end_hash)) {
+      finish(rp, REPLAY_DIVERGED);
+    } else {
+      finish(rp, REPLAY_OK);
+    }
+  } else if (complete(&rp->hdr) ? gm->sched.now >= rp->hdr.end_tick
+                                : !rp->ev_pending) {
+    // a complete game should have ended, an incomplete log ran out
+    finish(rp, complete(&rp->hdr) ? REPLAY_DIVERGED : REPLAY_OK);
+  }
+  return gm->state;
+}
+
+/**
+ * @brief Plays the rest of the recording.
+ * @return REPLAY_OK if it ended as recorded.
+ */
+ReplayStatus replay_run(Replay *rp) {
+  if (rp == NULL) return REPLAY_BAD;
+  while (!rp->done) replay_tick(rp);
+  return rp->status;
+}
+
+/**
+ * @brief Logic ticks played so far.
+ */
+uint32_t replay_now(const Replay *rp) {
+  return rp != NULL && rp->gm != NULL ? rp->gm->sched.now : 0;
+}
+
+/*******************************EOF replay.c*******************************/
@@ -0,0 +1,69 @@
+/**
+ * @file rng.c
+ * @brief Seeding and stream splitting of the xoshiro128** generator, after
+ * the reference implementation by Blackman and Vigna.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "rng.h"
+
+#include <stddef.h>
+
+// Jump polynomial of 2^64 steps
+static const uint32_t JUMP[4] = {0x8764000b, 0xf542d2d3, 0x6fa035c3,
+                                 0x77f2db5b};
+
+static uint64_t splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15u);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Seeds the generator, every seed (0 included) gives a valid state and
+ * close seeds give unrelated sequences.
+ * @param rng The generator.
+ * @param seed The seed, expanded with SplitMix64.
+ */
+void rng_seed(Rng *rng, uint64_t seed) {
+  if (rng == NULL) return;
+  uint64_t a = splitmix64(&seed);
+  uint64_t b = splitmix64(&seed);
+  rng->s[0] = (uint32_t)a;
+  rng->s[1] = (uint32_t)(a >> 32);
+  rng->s[2] = (uint32_t)b;
+  rng->s[3] = (uint32_t)(b >> 32);
+  if ((a | b) == 0) rng->s[0] = 1;  // the all-zero state never leaves zero
+}
+
+/**
+ * @brief Advances the generator by 2^64 numbers.
+ */
+void rng_jump(Rng *rng) {
+  if (rng == NULL) return;
+  uint32_t s[4] = {0, 0, 0, 0};
+  for (int i = 0; i < 4; ++i) {
+    for (int b = 0; b < 32; ++b) {
+      if (JUMP[i] & (1u << b)) {
+        for (int k = 0; k < 4; ++k) s[k] ^= rng->s[k];
+      }
+      rng_next(rng);
+    }
+  }
+  for (int k = 0; k < 4; ++k) rng->s[k] = s[k];
+}
+
+/**
+ * @brief Splits off a stream of 2^64 numbers: stream gets the current state
+ * and rng jumps past it, so repeated splits give non-overlapping streams.
+ * @param rng The generator split from.
+ * @param stream The new independent generator.
+ */
+void rng_split(Rng *rng, Rng *stream) {
+  if (rng == NULL || stream == NULL) return;
+  *stream = *rng;
+  rng_jump(rng);
+}
+
+/*********************************EOF rng.c*********************************/
@@ -0,0 +1,125 @@
+/**
+ * @file scan_prof.c
+ * @brief Implementation of the scan profile. The scan task is the only writer
+ * of the counters and brackets every update with a sequence count (seqlock),
+ * readers on the other core retry until they copied a consistent snapshot.
+ * Neither side ever waits for the other.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "scan_prof.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "esp_rom_sys.h"
+
+static ScanProfStats prof;
+static _Atomic uint32_t prof_seq;      // odd while the writer updates prof
+static _Atomic bool reset_requested;   // carried out by the writer
+static uint32_t nominal;               // dwell in cycles
+static uint32_t last_start;            // start of the previous step
+
+static void clear(void) {
+  prof = (ScanProfStats){.period_min = UINT32_MAX};
+}
+
+/**
+ * @brief Sets the expected period, call on the scan task before the first
+ * step.
+ * @param dwell_us Time between two column alarms.
+ */
+void scan_prof_init(uint32_t dwell_us) {
+  nominal = dwell_us * esp_rom_get_cpu_ticks_per_us();
+  clear();
+}
+
+/**
+ * @brief Adds a measured step to the counters, scan task only.
+ */
+void IRAM_ATTR scan_prof_commit(const ScanProfRun *run, uint32_t alarms) {
+  uint32_t seq = atomic_load_explicit(&prof_seq, memory_order_relaxed);
+  atomic_store_explicit(&prof_seq, seq + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+
+  if (atomic_exchange_explicit(&reset_requested, false, memory_order_relaxed)) {
+    clear();
+    last_start = 0;
+  }
+  uint32_t busy = run->last - run->start;
+  if (prof.steps++ > 0 && last_start != 0) {
+    uint32_t period = run->start - last_start;
+    if (period < prof.period_min) prof.period_min = period;
+    if (period > prof.period_max) prof.period_max = period;
+    if (period > nominal + nominal / 8) prof.late++;
+  }
+  last_start = run->start;
+  if (alarms > 1) prof.missed += alarms - 1;
+  if (busy > nominal) prof.overruns++;
+  if (busy > prof.busy_max) prof.busy_max = busy;
+  prof.busy_sum += busy;
+  if (run->wake > prof.wake_max) prof.wake_max = run->wake;
+  prof.wake_sum += run->wake;
+  for (int i = 0; i < SP_PHASES; ++i) {
+    if (run->phase[i] > prof.phase_max[i]) prof.phase_max[i] = run->phase[i];
+    prof.phase_sum[i] += run->phase[i];
+  }
+
+  atomic_store_explicit(&prof_seq, seq + 2, memory_order_release);
+}
+
+/**
+ * @brief Asks the scan task to clear the counters at its next step.
+ */
+void scan_prof_reset(void) {
+  atomic_store_explicit(&reset_requested, true, memory_order_relaxed);
+}
+
+/**
+ * @brief Copies a consistent snapshot of the counters, from any task.
+ */
+void scan_prof_get(ScanProfStats *out) {
+  if (out == NULL) return;
+  uint32_t before, after;
+  do {
+    before = atomic_load_explicit(&prof_seq, memory_order_acquire);
+    *out = prof;
+    atomic_thread_fence(memory_order_acquire);
+    after = atomic_load_explicit(&prof_seq, memory_order_relaxed);
+  } while ((before & 1) || before != after);
+}
+
+/**
+ * @brief Prints the profile in microseconds.
+ */
+void scan_prof_print(void) {
+#if SCAN_PROFILE
+  static const char *const names[SP_PHASES] = {"load", "pack", "spi", "gpio",
+                                               "frame"};
+  ScanProfStats st;
+  scan_prof_get(&st);
+  double us = esp_rom_get_cpu_ticks_per_us();
+  double n = st.steps ? st.steps : 1;
+  printf("scan     %lu steps, %lu missed, %lu overruns, %lu late\n",
+         (unsigned long)st.steps, (unsigned long)st.missed,
+         (unsigned long)st.overruns, (unsigned long)st.late);
+  if (st.steps == 0) return;
+  printf("scan     busy %.2f us mean, %.2f us max of %.0f us dwell\n",
+         st.busy_sum / n / us, st.busy_max / us, nominal / us);
+  if (st.period_max) {
+    printf("scan     period %.2f..%.2f us, wake %.2f us mean, %.2f us max\n",
+           st.period_min / us, st.period_max / us, st.wake_sum / n / us,
+           st.wake_max / us);
+  }
+  for (int i = 0; i < SP_PHASES; ++i) {
+    if (st.phase_max[i] == 0) continue;  // not on this scan path
+    printf("scan     %-6s %.3f us mean, %.3f us max\n", names[i],
+           st.phase_sum[i] / n / us, st.phase_max[i] / us);
+  }
+#else
+  printf("scan     profiling disabled (SCAN_PROFILE 0)\n");
+#endif
+}
+
+/*****************************EOF scan_prof.c*******************************/
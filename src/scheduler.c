@@ -0,0 +1,102 @@
+/**
+ * @file scheduler.c
+ * @brief Implementation of the timing wheel that drives the game: snake moves,
+ * spawn rolls and fruit expiry. Every event hashes into the bucket of its due
+ * tick, so a tick only looks at one bucket instead of every fruit.
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "scheduler.h"
+
+#include <string.h>
+
+#include "models.h"
+
+// Unlinks an armed event from its bucket
+static void unlink_node(Scheduler *sched, uint8_t event) {
+  SchedNode *node = &sched->nodes[event];
+  if (node->prev != SCHED_NONE) {
+    sched->nodes[node->prev].next = node->next;
+  } else {
+    sched->bucket[node->due & (SCHED_WHEEL_SIZE - 1)] = node->next;
+  }
+  if (node->next != SCHED_NONE) sched->nodes[node->next].prev = node->prev;
+  node->state = SCHED_IDLE;
+}
+
+/**
+ * @brief Empties the wheel and restarts the tick count.
+ * @param sched Pointer to the Scheduler structure.
+ */
+void sched_init(Scheduler *sched) {
+  if (sched == NULL) return;
+  sched->now = 0;
+  memset(sched->bucket, SCHED_NONE, sizeof(sched->bucket));
+  memset(sched->nodes, 0, sizeof(sched->nodes));
+}
+
+/**
+ * @brief Schedules an event delay ticks from now, rescheduling it if it was
+ * already pending.
+ * @param sched Pointer to the Scheduler structure.
+ * @param event Event id (EV_*).
+ * @param delay Ticks from now, 0 is treated as 1 (the next tick).
+ */
+void sched_at(Scheduler *sched, uint8_t event, uint32_t delay) {
+  if (sched == NULL || event >= SCHED_EVENTS) return;
+  if (sched_pending(sched, event)) unlink_node(sched, event);
+  SchedNode *node = &sched->nodes[event];
+  node->due = sched->now + (delay ? delay : 1);
+  uint8_t *head = &sched->bucket[node->due & (SCHED_WHEEL_SIZE - 1)];
+  node->prev = SCHED_NONE;
+  node->next = *head;
+  if (*head != SCHED_NONE) sched->nodes[*head].prev = event;
+  *head = event;
+  node->state = SCHED_ARMED;
+}
+
+/**
+ * @brief Drops a pending event, or one that fired on this tick and was not
+ * handled yet. Nothing happens otherwise.
+ * @param sched Pointer to the Scheduler structure.
+ * @param event Event id (EV_*).
+ */
+void sched_cancel(Scheduler *sched, uint8_t event) {
+  if (sched == NULL || event >= SCHED_EVENTS) return;
+  if (sched_pending(sched, event)) unlink_node(sched, event);
+  sched->nodes[event].state = SCHED_IDLE;  // also drops a fired one
+}
+
+/**
+ * @brief Advances the wheel by one tick and collects the events due on it.
+ * Collected events are marked fired, periodic ones have to be scheduled again.
+ * The caller should skip the ones no longer sched_fired when it gets to them.
+ * @param sched Pointer to the Scheduler structure.
+ * @param due Array of at least SCHED_EVENTS entries, filled with the due
+ * event ids in ascending order.
+ * @return Number of due events.
+ */
+size_t sched_advance(Scheduler *sched, uint8_t *due) {
+  if (sched == NULL || due == NULL) return 0;
+  sched->now++;
+  size_t count = 0;
+  uint8_t event = sched->bucket[sched->now & (SCHED_WHEEL_SIZE - 1)];
+  while (event != SCHED_NONE) {
+    uint8_t next = sched->nodes[event].next;
+    if (sched->nodes[event].due == sched->now) {  // not a later wheel turn
+      unlink_node(sched, event);
+      sched->nodes[event].state = SCHED_FIRED;
+      // insertion keeps ids ascending, a bucket holds only a few events
+      size_t i = count++;
+      while (i > 0 && due[i - 1] > event) {
+        due[i] = due[i - 1];
+        i--;
+      }
+      due[i] = event;
+    }
+    event = next;
+  }
+  return count;
+}
+
+/*******************************EOF scheduler.c*******************************/
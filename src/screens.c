@@ -0,0 +1,68 @@
+/**
+ * @file screens.c
+ * @brief The won, lost and idle screens, expanded at compile time from 1-bpp
+ * bitmaps of the 16 leftmost columns. A bitmap row reads left to right, the
+ * most significant bit is column 0. Layers of one row never overlap, so their
+ * colors are simply or-ed together (black is 0).
+ * @author Vít Mrkvica (xmrkviv00)
+ * @date 17/10/2026
+ */
+#include "screens.h"
+
+#include "models.h"
+
+#if ROWS < 8 || COLS < 16
+#error "the screens need at least 8 rows and 16 columns"
+#endif
+
+#define PX(bits, c, color) ((((bits) >> (15 - (c))) & 1) ? (color) : BLACK_COLOR)
+#define PX4(c, b1, k1, b2, k2, b3, k3, b4, k4) \
+  (PX(b1, c, k1) | PX(b2, c, k2) | PX(b3, c, k3) | PX(b4, c, k4))
+#define ROW4(...)                                                    \
+  {PX4(0, __VA_ARGS__),  PX4(1, __VA_ARGS__),  PX4(2, __VA_ARGS__),  \
+   PX4(3, __VA_ARGS__),  PX4(4, __VA_ARGS__),  PX4(5, __VA_ARGS__),  \
+   PX4(6, __VA_ARGS__),  PX4(7, __VA_ARGS__),  PX4(8, __VA_ARGS__),  \
+   PX4(9, __VA_ARGS__),  PX4(10, __VA_ARGS__), PX4(11, __VA_ARGS__), \
+   PX4(12, __VA_ARGS__), PX4(13, __VA_ARGS__), PX4(14, __VA_ARGS__), \
+   PX4(15, __VA_ARGS__)}
+#define ROW(bits, color) ROW4(bits, color, 0, 0, 0, 0, 0, 0)
+
+// W
+const color_t WON_SCREEN[ROWS][COLS] = {
+    [ROWS - 8] = ROW(0b0000010000100000, WON_COLOR),
+    [ROWS - 7] = ROW(0b0000010000100000, WON_COLOR),
+    [ROWS - 6] = ROW(0b0000101001010000, WON_COLOR),
+    [ROWS - 5] = ROW(0b0000101001010000, WON_COLOR),
+    [ROWS - 4] = ROW(0b0001000110001000, WON_COLOR),
+    [ROWS - 3] = ROW(0b0001000110001000, WON_COLOR),
+    [ROWS - 2] = ROW(0b0010000000000100, WON_COLOR),
+    [ROWS - 1] = ROW(0b0010000000000100, WON_COLOR)};
+
+// L
+const color_t LOST_SCREEN[ROWS][COLS] = {
+    [ROWS - 8] = ROW(0b0000011111100000, LOST_COLOR),
+    [ROWS - 7] = ROW(0b0000011111100000, LOST_COLOR),
+    [ROWS - 6] = ROW(0b0000011000000000, LOST_COLOR),
+    [ROWS - 5] = ROW(0b0000011000000000, LOST_COLOR),
+    [ROWS - 4] = ROW(0b0000011000000000, LOST_COLOR),
+    [ROWS - 3] = ROW(0b0000011000000000, LOST_COLOR),
+    [ROWS - 2] = ROW(0b0000011000000000, LOST_COLOR),
+    [ROWS - 1] = ROW(0b0000011000000000, LOST_COLOR)};
+
+// "HAD" and the three difficulty bars, brackets around the selected one
+#define IDLE_TEXT                                        \
+  [ROWS - 5] = ROW(0b0101001001001100, TEXT_COLOR),      \
+  [ROWS - 4] = ROW(0b0111001111001010, TEXT_COLOR),      \
+  [ROWS - 3] = ROW(0b0111001001001010, TEXT_COLOR),      \
+  [ROWS - 2] = ROW(0b0101000110001100, TEXT_COLOR)
+#define IDLE_BARS(selected)                                                \
+  [ROWS - 7] = ROW4(0b0001100000000000, EASY_COLOR,                        \
+                    0b0000000110000000, MEDIUM_COLOR,                      \
+                    0b0000000000011000, HARD_COLOR, selected, SELECTED_COLOR)
+
+const color_t IDLE_SCREENS[3][ROWS][COLS] = {
+    [DIFF_EASY] = {IDLE_TEXT, IDLE_BARS(0b0010010000000000)},
+    [DIFF_MEDIUM] = {IDLE_TEXT, IDLE_BARS(0b0000001001000000)},
+    [DIFF_HARD] = {IDLE_TEXT, IDLE_BARS(0b0000000000100100)}};
+
+/*******************************EOF screens.c*********************************/
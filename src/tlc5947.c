@@ -8,7 +8,9 @@
 #include <string.h>
 
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_rom_sys.h"
+#include "fast_gpio.h"
 
 #define TLC5947_BITS_PER_CH 12
 #define TLC5947_CH_PER_CHIP 24
@@ -16,31 +18,26 @@
   (TLC5947_BITS_PER_CH * TLC5947_CH_PER_CHIP)               // 288
 #define TLC5947_BYTES_PER_CHIP (TLC5947_BITS_PER_CHIP / 8)  // 36
 
-static void pack_frame_msbfirst(const tlc5947_t *dev) {
-  memset(dev->tx, 0, dev->frame_bytes);
-
-  size_t bit_idx =
-      0;  // index bitu v dev->tx (MSB-first na drátu v rámci bajtu)
-  for (int chip = dev->chips - 1; chip >= 0; --chip) {
-    const int base = chip * TLC5947_CH_PER_CHIP;  // 24 kanálů na čip
-    for (int ch = TLC5947_CH_PER_CHIP; ch > 0; --ch) {
-      const uint16_t v =
-          dev->gs[base + (ch - 1)] & 0x0FFFu;  // 12bit hodnota kanálu
-
-      // MSB -> LSB (bity 11..0)
-      for (int b = 11; b >= 0; --b) {
-        if (v & (1u << b)) {
-          const size_t byte = bit_idx >> 3;
-          const int bit =
-              7 - (bit_idx & 7);  // SPI posílá MSB bitu bajtu jako první
-          dev->tx[byte] |= (uint8_t)(1u << bit);
-        }
-        ++bit_idx;
-      }
-    }
+void tlc5947_pack(const tlc5947_t *dev, uint8_t *out) {
+  // The last channel of the last chip goes out first, 12 bits MSB-first.
+  // Two channels are exactly 24 bits, so every step emits three whole bytes
+  // and no bit addressing (or pre-clear of the buffer) is needed.
+  const uint16_t *gs = dev->gs + dev->channels;
+  for (int i = dev->channels / 2; i > 0; --i) {
+    const uint32_t first = *--gs & 0x0FFFu;
+    const uint32_t second = *--gs & 0x0FFFu;
+    const uint32_t pair = (first << 12) | second;
+    out[0] = (uint8_t)(pair >> 16);
+    out[1] = (uint8_t)(pair >> 8);
+    out[2] = (uint8_t)pair;
+    out += 3;
   }
 }
 
+static void pack_frame_msbfirst(const tlc5947_t *dev) {
+  tlc5947_pack(dev, dev->tx);
+}
+
 esp_err_t tlc5947_init(tlc5947_t *dev, const tlc5947_config_t *cfg) {
   ESP_RETURN_ON_FALSE(dev && cfg, ESP_ERR_INVALID_ARG, "tlc5947", "null arg");
   memset(dev, 0, sizeof(*dev));
@@ -49,10 +46,15 @@ esp_err_t tlc5947_init(tlc5947_t *dev, const tlc5947_config_t *cfg) {
   dev->frame_bytes = cfg->chips * TLC5947_BYTES_PER_CHIP;
   dev->xlat_io = cfg->xlat_io;
   dev->blank_io = cfg->blank_io;
+  // latch signalling goes through the W1TS/W1TC registers (pins 0..31)
+  ESP_RETURN_ON_FALSE(dev->xlat_io < 32 && dev->blank_io < 32,
+                      ESP_ERR_INVALID_ARG, "tlc5947", "xlat/blank pin > 31");
+  dev->xlat_mask = FAST_GPIO_BIT(dev->xlat_io);
+  dev->blank_mask = FAST_GPIO_BIT(dev->blank_io);
 
   // Buffers
   dev->gs = (uint16_t *)calloc(dev->channels, sizeof(uint16_t));
-  dev->tx = (uint8_t *)calloc(dev->frame_bytes, 1);
+  dev->tx = (uint8_t *)heap_caps_calloc(dev->frame_bytes, 1, MALLOC_CAP_DMA);
   ESP_RETURN_ON_FALSE(dev->gs && dev->tx, ESP_ERR_NO_MEM, "tlc5947", "alloc");
 
   // SPI bus/device
@@ -75,7 +77,7 @@ esp_err_t tlc5947_init(tlc5947_t *dev, const tlc5947_config_t *cfg) {
       .clock_speed_hz = cfg->clock_hz > 0 ? cfg->clock_hz : 10 * 1000 * 1000,
       .mode = 0,           // CPOL=0, CPHA=0 (data latch on rising edge)
       .spics_io_num = -1,  // no CS pin on TLC5947
-      .queue_size = 1,
+      .queue_size = 2,
       .flags = SPI_DEVICE_NO_DUMMY};
   spi_bus_add_device(cfg->host, &ifc, &dev->spi);
 
@@ -98,13 +100,14 @@ esp_err_t tlc5947_init(tlc5947_t *dev, const tlc5947_config_t *cfg) {
 
 void tlc5947_deinit(tlc5947_t *dev) {
   if (!dev) return;
+  tlc5947_pipeline_end(dev);
   if (dev->spi) {
     spi_device_handle_t h = dev->spi;
     dev->spi = NULL;
     spi_bus_remove_device(h);
   }
   if (dev->tx) {
-    free(dev->tx);
+    heap_caps_free(dev->tx);
     dev->tx = NULL;
   }
   if (dev->gs) {
@@ -130,25 +133,66 @@ uint16_t tlc5947_u8_to_u12_gamma(uint8_t x) {
 
 esp_err_t tlc5947_update(tlc5947_t *dev, bool vblank_sync) {
   pack_frame_msbfirst(dev);
+  return tlc5947_update_packed(dev, dev->tx, vblank_sync);
+}
 
-  spi_transaction_t t = {.length = dev->frame_bytes * 8, .tx_buffer = dev->tx};
+esp_err_t tlc5947_update_packed(tlc5947_t *dev, const uint8_t *tx,
+                                bool vblank_sync) {
+  tlc5947_shift_wait(dev);  // never overlap a pipelined transfer
+  spi_transaction_t t = {.length = dev->frame_bytes * 8, .tx_buffer = tx};
   spi_device_transmit(dev->spi, &t);
+  tlc5947_latch(dev, vblank_sync);
+  return ESP_OK;
+}
 
+void tlc5947_latch(const tlc5947_t *dev, bool vblank_sync) {
   if (vblank_sync) {
     // BLANK high → XLAT pulse → BLANK low
-    gpio_set_level(dev->blank_io, 1);
-    gpio_set_level(dev->xlat_io, 1);
+    fast_gpio_set(dev->blank_mask);
+    fast_gpio_set(dev->xlat_mask);
     // datasheet povoluje SCLK až 100 ns po XLAT↑ – 1 us je pohodlná rezerva
     esp_rom_delay_us(1);
-    gpio_set_level(dev->xlat_io, 0);
-    gpio_set_level(dev->blank_io, 0);
+    fast_gpio_clear(dev->xlat_mask);
+    fast_gpio_clear(dev->blank_mask);
   } else {
     // Rychlé latnutí – krátký „black frame“ během přepnutí je možný
-    gpio_set_level(dev->xlat_io, 1);
+    fast_gpio_set(dev->xlat_mask);
     esp_rom_delay_us(1);
-    gpio_set_level(dev->xlat_io, 0);
+    fast_gpio_clear(dev->xlat_mask);
   }
-  return ESP_OK;
+}
+
+esp_err_t tlc5947_pipeline_begin(tlc5947_t *dev) {
+  if (dev->bus_acquired) return ESP_OK;
+  // Holding the bus lets polling transactions skip the arbitration each time
+  esp_err_t err = spi_device_acquire_bus(dev->spi, portMAX_DELAY);
+  if (err == ESP_OK) dev->bus_acquired = true;
+  return err;
+}
+
+void tlc5947_pipeline_end(tlc5947_t *dev) {
+  tlc5947_shift_wait(dev);
+  if (dev->bus_acquired) {
+    spi_device_release_bus(dev->spi);
+    dev->bus_acquired = false;
+  }
+}
+
+esp_err_t tlc5947_shift_start(tlc5947_t *dev, const uint8_t *tx) {
+  tlc5947_shift_wait(dev);
+  dev->trans = (spi_transaction_t){.length = dev->frame_bytes * 8,
+                                   .tx_buffer = tx};
+  // The transfer runs on DMA in the background, the latched data keeps
+  // driving the outputs until the next tlc5947_latch
+  esp_err_t err = spi_device_polling_start(dev->spi, &dev->trans, portMAX_DELAY);
+  dev->shifting = (err == ESP_OK);
+  return err;
+}
+
+esp_err_t tlc5947_shift_wait(tlc5947_t *dev) {
+  if (!dev->shifting) return ESP_OK;
+  dev->shifting = false;
+  return spi_device_polling_end(dev->spi, portMAX_DELAY);
 }
 
 void tlc5947_set_blank(const tlc5947_t *dev, bool blank) {
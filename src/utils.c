@@ -7,9 +7,8 @@
 #include "utils.h"
 
 #include "dir_queue.h"
-#include "esp_random.h"
-#include "globals.h"
 #include "models.h"
+#include "rng.h"
 
 /**
  * @brief Checks if the given direction conflicts with the last direction in
@@ -38,27 +37,30 @@ bool conflictDir(Direction d, Direction last, GameManager *gm) {
 /**
  * @brief Inserts a new direction into the direction queue if it does not
  * conflict with the last direction or the snake's current direction.
+ * @param queue The direction queue of the game.
  * @param dir The new direction to insert.
  * @param gm Pointer to the GameManager structure.
  */
-void insert_dir(Direction dir,
+void insert_dir(Queue *queue, Direction dir,
                 GameManager *gm) {  // only inserts the direction if allowed
-  if (gm == NULL) return;
+  if (queue == NULL || gm == NULL) return;
   Direction last_dir = DIR_EMPTY;
-  queue_peek_last(&direction, &last_dir);
+  queue_peek_last(queue, &last_dir);
   if (!conflictDir(dir, last_dir, gm)) {
-    queue_push(&direction, dir);
+    queue_push(queue, dir);
   }
 }
 
 /**
  * @brief Generates a random integer within the specified range [min, max].
+ * Every value is equally likely, the sequence only depends on the seed.
+ * @param rng The generator, usually the one of a GameManager.
  * @param min The minimum value of the range.
  * @param max The maximum value of the range.
  * @return A random integer between min and max (inclusive).
  */
-int rand_range(int min, int max) {
-  return esp_random() % (max - min + 1) + min;
+int rand_range(Rng *rng, int min, int max) {
+  return min + (int)rng_below(rng, (uint32_t)(max - min) + 1);
 }
 
 /********************************EOF utils.c*********************************/
\ No newline at end of file